@@ -0,0 +1,215 @@
+//-------------------------------------------------------------------------------------------------
+// File: copyto.cpp
+// Author: Dennis Lang
+//
+// Desc: Copy matched files to a mirror tree under new names (-copyTo)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "copyto.hpp"
+#include "directory.hpp"
+#include "filecopy.hpp"
+#include "threadpool.hpp"
+#include "stats.hpp"
+#include "progress.hpp"
+#include "eventlog.hpp"
+#include "errors.hpp"
+#include "signals.hpp"
+#include "parseutil.hpp"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <vector>
+
+#ifndef PATH_MAX
+#define PATH_MAX 4096
+#endif
+#ifdef HAVE_WIN
+#include <direct.h>
+#define realpath(path, full) _fullpath(full, path, PATH_MAX)
+#define getcwd _getcwd
+#else
+#include <unistd.h>
+#endif
+
+bool CopyTo::enabled = false;
+bool CopyTo::dryRun = false;
+unsigned CopyTo::threads = 0;
+std::atomic<unsigned> CopyTo::copied { 0 };
+
+struct CopyItem {
+    lstring srcPath;
+    lstring dstPath;
+};
+struct CopyBatch {
+    lstring dstDir;
+    std::vector<CopyItem> items;
+};
+
+static lstring destRoot;
+static lstring scanRoot;
+static ThreadPool* pool = nullptr;
+static CopyBatch* batch = nullptr;
+
+//-------------------------------------------------------------------------------------------------
+static bool fullPath(lstring& outPath, const char* path) {
+    char full[PATH_MAX];
+    if (realpath(path, full) == nullptr)
+        return false;
+    outPath = full;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool CopyTo::open(const char* destDir, bool _dryRun) {
+    dryRun = _dryRun;
+    if (!dryRun && !FileCopy::makeDirs(destDir))
+        return false;
+    if (!fullPath(destRoot, destDir)) {
+        // Dry run of a destination not created yet.
+        char cwd[PATH_MAX];
+        if (!dryRun || errno != ENOENT)
+            return false;
+        bool isAbs = destDir[0] == '/' || destDir[0] == '\\' || (destDir[0] != '\0' && destDir[1] == ':');
+        if (isAbs)
+            destRoot = destDir;
+        else if (getcwd(cwd, sizeof(cwd)) != nullptr)
+            DirUtil::join(destRoot, cwd, destDir);
+        else
+            return false;
+    }
+    enabled = true;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Scanner returns real paths, root is the directory argument or the directory
+// of a file or wildcard argument.
+bool CopyTo::setRoot(const lstring& scanArg) {
+    struct stat info;
+    lstring dir = scanArg;
+    if (stat(scanArg, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        DirUtil::getDir(dir, scanArg);
+        if (dir.empty())
+            dir = ".";
+    }
+    if (!fullPath(scanRoot, dir))
+        return false;
+    lstring rootSlash = scanRoot + Directory_files::SLASH;
+    return destRoot != scanRoot && strncmp(destRoot, rootSlash, rootSlash.length()) != 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void copyBatch(CopyBatch* work) {
+    if (CopyTo::dryRun) {
+        for (const CopyItem& item : work->items) {
+            CopyTo::copied++;
+            Progress::inc(Progress::renamed);
+            Colors::showError("", " copy ", item.srcPath, "\n     to ", item.dstPath);
+        }
+        delete work;
+        return;
+    }
+    if (!FileCopy::makeDirs(work->dstDir)) {
+        int err = errno;
+        for (const CopyItem& item : work->items) {
+            Stats::failure(err);
+            Errors::add(err, " mkdir ", work->dstDir, item.srcPath, item.dstPath);
+        }
+        delete work;
+        return;
+    }
+
+    for (const CopyItem& item : work->items) {
+        if (Signals::aborted)
+            break;
+        uint64_t startNs = Stats::wallNow();
+        if (FileCopy::copy(item.srcPath, item.dstPath)) {
+            CopyTo::copied++;
+            Stats::add(Stats::RENAMED);
+            Progress::inc(Progress::renamed);
+            EventLog::write(EventLog::APPLY, item.srcPath, item.dstPath, 0, Stats::wallNow() - startNs);
+        } else {
+            int err = errno;
+            Stats::failure(err);
+            EventLog::write(EventLog::FAIL, item.srcPath, item.dstPath, err, Stats::wallNow() - startNs);
+            Errors::add(err, " copy ", work->dstDir, item.srcPath, item.dstPath);
+        }
+    }
+    delete work;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void submitBatch() {
+    if (batch != nullptr) {
+        CopyBatch* work = batch;
+        batch = nullptr;
+        if (CopyTo::dryRun)
+            copyBatch(work);    // listed in scan order
+        else
+            pool->add([work]() { copyBatch(work); });
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void CopyTo::add(const lstring& srcPath, const lstring& newPath) {
+    lstring dstPath = destRoot;
+    if (strncmp(newPath, scanRoot, scanRoot.length()) == 0) {
+        dstPath += newPath.substr(scanRoot.length());
+    } else {
+        lstring name;       // relative file argument
+        dstPath += Directory_files::SLASH + DirUtil::getName(name, newPath);
+    }
+    lstring dstDir;
+    DirUtil::getDir(dstDir, dstPath);
+
+    if (pool == nullptr)
+        pool = new ThreadPool(threads);
+    if (batch != nullptr && (batch->dstDir != dstDir || batch->items.size() >= BATCH_MAX))
+        submitBatch();
+    if (batch == nullptr) {
+        batch = new CopyBatch();
+        batch->dstDir = dstDir;
+    }
+    EventLog::write(EventLog::PLAN, srcPath, dstPath);
+    batch->items.push_back(CopyItem { srcPath, dstPath });
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void CopyTo::finish() {
+    if (pool == nullptr)
+        return;
+    submitBatch();
+    pool->wait();
+    delete pool;
+    pool = nullptr;
+}
@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------------------------
+// File: copyto.hpp
+// Author: Dennis Lang
+//
+// Desc: Copy matched files to a mirror tree under new names (-copyTo)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <atomic>
+
+//-------------------------------------------------------------------------------------------------
+// Instead of renaming, each matched file is copied to destDir + its renamed path below
+// the scan root, leaving the original in place. Files of one directory are handed to
+// a thread pool worker as one batch, so target directories are created once and
+// independent directories copy in parallel. A dry run only lists the copies.
+class CopyTo {
+public:
+    static const size_t BATCH_MAX = 256;
+
+    static bool enabled;
+    static bool dryRun;
+    static unsigned threads;    // 0 = ThreadPool::defaultSize()
+    static std::atomic<unsigned> copied;    // files copied, or listed by a dry run
+
+    // Set destination directory, relative paths resolve from current directory.
+    // A dry run does not create it.
+    static bool open(const char* destDir, bool dryRun);
+    // Set root of following scanned paths, false if destination is inside root.
+    static bool setRoot(const lstring& scanArg);
+    // Queue copy of srcPath, newPath is the renamed srcPath.
+    static void add(const lstring& srcPath, const lstring& newPath);
+    // Copy remaining batches and wait.
+    static void finish();
+};
@@ -0,0 +1,227 @@
+//-------------------------------------------------------------------------------------------------
+// File: dedup.cpp
+// Author: Dennis Lang
+//
+// Desc: Find duplicate files and consolidate them (-dedup)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "dedup.hpp"
+#include "directory.hpp"
+#include "filecopy.hpp"
+#include "hash.hpp"
+#include "threadpool.hpp"
+#include "parseutil.hpp"
+#include "signals.hpp"
+
+#include <errno.h>
+#include <iostream>
+#include <map>
+#include <set>
+#include <vector>
+
+struct DedupFile {
+    lstring path;
+    FileMeta meta;
+};
+typedef std::vector<size_t> Group;     // index into files
+
+Dedup::Mode Dedup::mode = Dedup::OFF;
+
+static std::vector<DedupFile> files;
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Dedup::add(const lstring& path, const FileMeta& meta) {
+    if (meta.valid && S_ISREG(meta.mode) && meta.size != 0)
+        files.push_back(DedupFile { path, meta });
+}
+
+//-------------------------------------------------------------------------------------------------
+// Hash every member of groups on pool, return groups split by hash, singles dropped.
+template <typename HashFn>
+static std::vector<Group> splitGroups(const std::vector<Group>& groups, ThreadPool& pool, HashFn hashOf) {
+    std::vector<uint64_t> hashes(files.size());
+    std::vector<char> hashOk(files.size(), 0);
+    for (const Group& group : groups) {
+        for (size_t idx : group) {
+            pool.add([idx, &hashes, &hashOk, &hashOf]() {
+                if (!Signals::aborted)
+                    hashOk[idx] = hashOf(files[idx], hashes[idx]);
+            });
+        }
+    }
+    pool.wait();
+
+    std::vector<Group> outGroups;
+    for (const Group& group : groups) {
+        std::map<uint64_t, Group> byHash;
+        for (size_t idx : group) {
+            if (hashOk[idx])
+                byHash[hashes[idx]].push_back(idx);
+        }
+        for (auto& item : byHash) {
+            if (item.second.size() > 1)
+                outGroups.push_back(std::move(item.second));
+        }
+    }
+    return outGroups;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Replace dupPath with clone of masterPath, keeping dupPath permissions.
+static bool cloneOver(const char* masterPath, const char* dupPath, unsigned dupMode) {
+    lstring tmpPath = dupPath;
+    tmpPath += "_llclone";
+    if (!FileCopy::clone(masterPath, tmpPath))
+        return false;
+    chmod(tmpPath, dupMode & 07777);
+    if (rename(tmpPath, dupPath) != 0) {
+        int err = errno;
+        DirUtil::deleteFile(false, tmpPath);
+        errno = err;
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Dedup::run(bool dryRun, bool verbose, unsigned threads) {
+    if (mode == OFF || files.empty())
+        return;
+
+    // Group by size, skip extra names of the same inode, they are already one file.
+    std::map<uint64_t, Group> bySize;
+    for (size_t idx = 0; idx < files.size(); idx++)
+        bySize[files[idx].meta.size].push_back(idx);
+
+    size_t alreadyCnt = 0;
+    std::vector<Group> groups;
+    for (auto& item : bySize) {
+        if (item.second.size() < 2)
+            continue;
+        std::set<std::pair<uint64_t, uint64_t>> inodes;
+        Group group;
+        for (size_t idx : item.second) {
+            if (inodes.insert(std::make_pair(files[idx].meta.dev, files[idx].meta.inode)).second)
+                group.push_back(idx);
+            else
+                alreadyCnt++;
+        }
+        if (group.size() > 1)
+            groups.push_back(std::move(group));
+    }
+
+    ThreadPool pool(threads);
+    groups = splitGroups(groups, pool, [](DedupFile& file, uint64_t& hash) {
+        return Hash::ofFile(file.path, hash, HEAD_LEN);
+    });
+
+    // Head hash covered all of a small file, full hash only for larger files.
+    std::vector<Group> large;
+    std::vector<Group> dupGroups;
+    for (Group& group : groups) {
+        if (files[group[0]].meta.size > HEAD_LEN)
+            large.push_back(std::move(group));
+        else
+            dupGroups.push_back(std::move(group));
+    }
+    large = splitGroups(large, pool, [](DedupFile& file, uint64_t& hash) {
+        bool okay = file.meta.need(file.path, FileMeta::bit(FileMeta::HASH));
+        hash = file.meta.hash;
+        return okay;
+    });
+    for (Group& group : large)
+        dupGroups.push_back(std::move(group));
+
+    // Byte compare each duplicate with first file of its group.
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (const Group& group : dupGroups) {
+        for (size_t idx = 1; idx < group.size(); idx++)
+            pairs.push_back(std::make_pair(group[0], group[idx]));
+    }
+    std::vector<char> same(pairs.size(), 0);
+    for (size_t idx = 0; idx < pairs.size(); idx++) {
+        pool.add([idx, &pairs, &same]() {
+            if (!Signals::aborted)
+                same[idx] = FileCopy::sameContent(files[pairs[idx].first].path, files[pairs[idx].second].path);
+        });
+    }
+    pool.wait();
+
+    size_t dupCnt = 0, doneCnt = 0, failCnt = 0, crossDevCnt = 0;
+    uint64_t reclaimed = 0;
+    for (size_t idx = 0; idx < pairs.size() && !Signals::aborted; idx++) {
+        if (!same[idx])
+            continue;
+        dupCnt++;
+        const DedupFile& master = files[pairs[idx].first];
+        const DedupFile& dup = files[pairs[idx].second];
+        if (master.meta.dev != dup.meta.dev) {
+            crossDevCnt++;
+            continue;
+        }
+
+        bool okay;
+        if (mode == LINK) {
+            LinkStatus status = DirUtil::hardlink(dryRun, master.path, dup.path);
+            okay = (status == DONE || status == DRYRUN);
+            if (verbose || !okay)
+                DirUtil::showLink(status, master.path, dup.path);
+        } else if (dryRun) {
+            std::cerr << "Would clone " << master.path << " to " << dup.path << std::endl;
+            okay = true;
+        } else {
+            okay = cloneOver(master.path, dup.path, dup.meta.mode);
+            if (!okay)
+                Colors::showError(strerror(errno), " clone ", master.path, " to ", dup.path);
+            else if (verbose)
+                std::cerr << "Cloned " << master.path << " to " << dup.path << std::endl;
+        }
+        if (okay) {
+            doneCnt++;
+            // Data of a duplicate with other hardlinks stays in use.
+            if (dup.meta.nlink == 1)
+                reclaimed += dup.meta.size;
+        } else {
+            failCnt++;
+        }
+    }
+
+    std::cerr << "Dedup groups=" << dupGroups.size()
+        << " duplicates=" << dupCnt
+        << (dryRun ? " wouldConsolidate=" : (mode == LINK ? " linked=" : " cloned=")) << doneCnt
+        << " alreadyLinked=" << alreadyCnt;
+    if (failCnt != 0)
+        std::cerr << " failed=" << failCnt;
+    if (crossDevCnt != 0)
+        std::cerr << " otherDevice=" << crossDevCnt;
+    std::cerr << (dryRun ? " wouldReclaim=" : " reclaimed=") << reclaimed << " bytes\n";
+}
@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------
+// File: dedup.hpp
+// Author: Dennis Lang
+//
+// Desc: Find duplicate files and consolidate them (-dedup)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+#include "filemeta.hpp"
+
+//-------------------------------------------------------------------------------------------------
+// Files seen by the rename pass are collected, then narrowed to duplicates by size,
+// hash of the first HEAD_LEN bytes and hash of the full file. Each stage runs on a
+// thread pool and only reads files still in a group. Candidates are byte compared
+// before the duplicate is replaced by a hardlink or clone of the first file found.
+class Dedup {
+public:
+    enum Mode { OFF, LINK, CLONE };
+    static const uint64_t HEAD_LEN = 64 * 1024;
+
+    static Mode mode;
+
+    // Collect regular file, meta needs STAT.
+    static void add(const lstring& path, const FileMeta& meta);
+    // Paths must resolve from the current directory.
+    static void run(bool dryRun, bool verbose, unsigned threads);
+};
@@ -30,6 +30,7 @@
 
 #include "ll_stdhdr.hpp"
 #include "directory.hpp"
+#include "stats.hpp"
 
 #include <iostream>
 
@@ -247,45 +248,41 @@ bool DirUtil::makeWriteableFile(const char* filePath, struct stat* info) {
 
 //-------------------------------------------------------------------------------------------------
 // [static] Extract directory part from path.
-lstring& DirUtil::getDir(lstring& outDir, const lstring& inPath) {
+lstring& DirUtil::getDir(lstring& outDir, std::string_view inPath) {
     size_t nameStart = inPath.rfind(SLASH_CHAR);
     if (nameStart == string::npos)
         outDir.clear();
     else
-        outDir = inPath.substr(0, nameStart);
+        outDir.assign(inPath.data(), nameStart);
     return outDir;
 }
 
 //-------------------------------------------------------------------------------------------------
 // Extract name part from path.
-lstring& DirUtil::getName(lstring& outName, const lstring& inPath) {
+lstring& DirUtil::getName(lstring& outName, std::string_view inPath) {
     size_t nameStart = inPath.rfind(SLASH_CHAR);
-    if (nameStart == std::string::npos)
-        outName = inPath;
-    else
-        outName = inPath.substr(nameStart + 1);
+    if (nameStart != std::string::npos)
+        inPath.remove_prefix(nameStart + 1);
+    outName.assign(inPath.data(), inPath.length());
     return outName;
 }
 
 //-------------------------------------------------------------------------------------------------
 // Extract name part from path.
-lstring& DirUtil::removeExtn(lstring& outName, const lstring& inPath) {
+lstring& DirUtil::removeExtn(lstring& outName, std::string_view inPath) {
     size_t extnPos = inPath.rfind(EXTN_CHAR);
-    if (extnPos == std::string::npos)
-        outName = inPath;
-    else
-        outName = inPath.substr(0, extnPos);
+    outName.assign(inPath.data(), (extnPos == std::string::npos) ? inPath.length() : extnPos);
     return outName;
 }
 
 //-------------------------------------------------------------------------------------------------
 // Extract name part from path.
-lstring& DirUtil::getExt(lstring& outExt, const lstring& inPath) {
+lstring& DirUtil::getExt(lstring& outExt, std::string_view inPath) {
     size_t extPos = inPath.rfind(EXTN_CHAR);
     if (extPos == std::string::npos)
-        outExt = "";
+        outExt.clear();
     else
-        outExt = inPath.substr(extPos + 1);
+        outExt.assign(inPath.data() + extPos + 1, inPath.length() - extPos - 1);
     return outExt;
 }
 
@@ -497,6 +494,7 @@ size_t DirUtil::fileLength(const lstring& path) {
 
 //-------------------------------------------------------------------------------------------------
 bool DirUtil::fileExists(const char* path) {
+    Stats::add(Stats::SYS_ACCESS);
 #ifdef HAVE_WIN
     const DWORD attr = GetFileAttributes(path);
     return ( attr != INVALID_FILE_ATTRIBUTES );
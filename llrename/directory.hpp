@@ -140,10 +140,10 @@ enum DIR_TYPES { IS_FILE, IS_DIR_BEG, IS_DIR_END };
 enum LinkStatus { DRYRUN, ALREADY, DONE, FAIL_BACKUP, FAIL_LINK, FAIL_RESTORE, FAIL_DEL_BACKUP };
 
 namespace DirUtil {
- lstring& getDir(lstring& outName, const lstring& inPath);
- lstring& getName(lstring& outName, const lstring& inPath);
- lstring& getExt(lstring& outExt, const lstring& inPath);
- lstring& removeExtn(lstring& outName, const lstring& inPath);
+ lstring& getDir(lstring& outName, std::string_view inPath);
+ lstring& getName(lstring& outName, std::string_view inPath);
+ lstring& getExt(lstring& outExt, std::string_view inPath);
+ lstring& removeExtn(lstring& outName, std::string_view inPath);
  bool deleteFile(bool dryRun, const char* inPath);
  bool setPermission(const char* inPath, unsigned permission, bool setAllParts = false);
  size_t fileLength(const lstring& path);
@@ -172,10 +172,13 @@ inline bool isWriteableFile(const struct stat& info) {
  // Utility to join directory and name and replace any double slashes with a single slash.
 inline const lstring& join(lstring& outPath, const char* inDir, const char* inName, unsigned int pathOff = 0) {
      // return realpath(fname.c_str(), my_fullname) or   GetFullPath(fname);
-     return ReplaceAll(( outPath = lstring(inDir+pathOff) + Directory_files::SLASH + inName ), Directory_files::SLASH2, Directory_files::SLASH);
+     outPath.assign(inDir + pathOff);
+     outPath += Directory_files::SLASH_CHAR;
+     outPath += inName;
+     return ReplaceAll(outPath, Directory_files::SLASH2, Directory_files::SLASH);
  }
 inline const lstring& join(lstring& outPath, lstring& inDir, const char* inName) {
-     return ReplaceAll(( outPath = inDir + Directory_files::SLASH + inName ), Directory_files::SLASH2, Directory_files::SLASH);
+     return join(outPath, inDir.c_str(), inName);
  }
 
 #ifdef  HAVE_WIN
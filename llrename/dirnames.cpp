@@ -0,0 +1,271 @@
+//-------------------------------------------------------------------------------------------------
+// File: dirnames.cpp
+// Author: Dennis Lang
+//
+// Desc: Cached directory listings to test rename targets without system calls
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "dirnames.hpp"
+#include "directory.hpp"
+#include "stats.hpp"
+
+#include <ctype.h>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/vfs.h>
+#include <linux/fs.h>
+#ifndef FS_CASEFOLD_FL
+#define FS_CASEFOLD_FL 0x40000000
+#endif
+#elif defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+bool DirNames::enabled = true;
+#if defined(__APPLE__) || defined(HAVE_WIN)
+bool DirNames::ignoreCase = true;
+#else
+bool DirNames::ignoreCase = false;
+#endif
+
+typedef std::unordered_set<std::string> NameSet;
+struct Listing {
+    std::vector<lstring> scanned;   // raw listing, turned into names on first use
+    NameSet names;
+    bool fold = false;
+    bool ready = false;
+};
+static std::unordered_map<std::string, Listing> listings;
+static std::deque<std::string> scanOrder;
+
+static const size_t MODES_MAX = 4096;
+static std::unordered_map<std::string, DirNames::CaseMode> caseModes;
+
+//-------------------------------------------------------------------------------------------------
+static const std::string& nameKey(const lstring& name, std::string& key, bool fold) {
+    if (!fold)
+        return name;
+    key.resize(name.length());
+    for (size_t idx = 0; idx < name.length(); idx++)
+        key[idx] = (char)tolower((unsigned char)name[idx]);
+    return key;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Stat a scanned name with its letters case flipped, same file means the directory folds case.
+// Returns -1 if no name has letters to flip.
+static int probeFolds(const lstring& dir, const std::vector<lstring>& names) {
+    const unsigned TRIES = 8;
+    unsigned tries = 0;
+    lstring path1, path2;
+    for (const lstring& name : names) {
+        lstring flip = name;
+        bool changed = false;
+        for (char& chr : flip) {
+            if (isalpha((unsigned char)chr)) {
+                chr = islower((unsigned char)chr) ? (char)toupper((unsigned char)chr) : (char)tolower((unsigned char)chr);
+                changed = true;
+            }
+        }
+        if (!changed || std::find(names.begin(), names.end(), flip) != names.end())
+            continue;
+        if (++tries > TRIES)
+            break;
+
+        struct stat info1, info2;
+        Stats::add(Stats::SYS_STAT);
+        if (stat(DirUtil::join(path1, dir, name), &info1) != 0)
+            continue;
+        Stats::add(Stats::SYS_STAT);
+        return (stat(DirUtil::join(path2, dir, flip), &info2) == 0
+            && info1.st_ino == info2.st_ino && info1.st_dev == info2.st_dev) ? 1 : 0;
+    }
+    return -1;
+}
+
+//-------------------------------------------------------------------------------------------------
+static DirNames::CaseMode detectCase(const lstring& dir, const std::vector<lstring>* names) {
+    DirNames::CaseMode defMode = DirNames::ignoreCase ? DirNames::FOLD : DirNames::EXACT;
+#if defined(__APPLE__)
+    long sensitive = pathconf(dir, _PC_CASE_SENSITIVE);
+    if (sensitive == 0)
+        return DirNames::FOLD;
+    if (sensitive == 1)
+        return DirNames::EXACT;
+#elif defined(__linux__)
+    struct statfs fsInfo;
+    if (statfs(dir, &fsInfo) == 0) {
+        switch ((unsigned long)fsInfo.f_type) {
+        case 0x4d44:        // vfat, msdos
+        case 0x2011BAB0:    // exfat
+            return DirNames::FOLD_HOP;
+        case 0xEF53:        // ext4
+        case 0xF2F52010:    // f2fs
+        {
+            // Per directory casefold attribute (chattr +F).
+            unsigned long flags = 0;
+            int fd = open(dir, O_RDONLY | O_DIRECTORY);
+            Stats::add(Stats::SYS_OPEN);
+            bool fold = fd >= 0 && ioctl(fd, FS_IOC_GETFLAGS, &flags) == 0 && (flags & FS_CASEFOLD_FL) != 0;
+            if (fd >= 0)
+                close(fd);
+            return fold ? DirNames::FOLD : DirNames::EXACT;
+        }
+        case 0x58465342:    // xfs
+        case 0x9123683E:    // btrfs
+        case 0x01021994:    // tmpfs
+        case 0x2FC12FC1:    // zfs
+            return DirNames::EXACT;
+        default:
+            break;          // ntfs, network and fuse mounts depend on mount options
+        }
+    }
+    if (names != nullptr) {
+        int folds = probeFolds(dir, *names);
+        if (folds >= 0)
+            return folds ? DirNames::FOLD : DirNames::EXACT;
+    }
+#endif
+    return defMode;
+}
+
+//-------------------------------------------------------------------------------------------------
+static DirNames::CaseMode findCaseMode(const lstring& dir, const std::vector<lstring>* names) {
+    auto iter = caseModes.find(dir);
+    if (iter != caseModes.end())
+        return iter->second;
+    if (caseModes.size() >= MODES_MAX)
+        caseModes.clear();
+    return caseModes[dir] = detectCase(dir, names);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Listing of dir, or nullptr if not cached. First use detects case mode and builds the name set.
+static Listing* findListing(const lstring& dir) {
+    auto iter = listings.find(dir);
+    if (iter == listings.end())
+        return nullptr;
+    Listing& listing = iter->second;
+    if (!listing.ready) {
+        listing.fold = findCaseMode(dir, &listing.scanned) != DirNames::EXACT;
+        listing.names.reserve(listing.scanned.size());
+        std::string key;
+        for (const lstring& name : listing.scanned)
+            listing.names.insert(nameKey(name, key, listing.fold));
+        std::vector<lstring>().swap(listing.scanned);
+        listing.ready = true;
+    }
+    return &listing;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void DirNames::scanned(const lstring& dir, std::vector<lstring>&& names) {
+    if (!enabled)
+        return;
+    if (listings.count(dir) == 0) {
+        while (scanOrder.size() >= DIR_MAX) {
+            listings.erase(scanOrder.front());
+            scanOrder.pop_front();
+        }
+        scanOrder.push_back(dir);
+    }
+
+    Listing& listing = listings[dir];
+    listing.names.clear();
+    listing.scanned = std::move(names);
+    listing.ready = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+DirNames::Found DirNames::exists(const lstring& dir, const lstring& name) {
+    Listing* listing = findListing(dir);
+    if (listing == nullptr)
+        return UNKNOWN;
+    Stats::add(Stats::NAME_CACHED);
+    std::string key;
+    return listing->names.count(nameKey(name, key, listing->fold)) != 0 ? YES : NO;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void DirNames::added(const lstring& dir, const lstring& name) {
+    Listing* listing = findListing(dir);
+    std::string key;
+    if (listing != nullptr)
+        listing->names.insert(nameKey(name, key, listing->fold));
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void DirNames::removed(const lstring& dir, const lstring& name) {
+    Listing* listing = findListing(dir);
+    std::string key;
+    if (listing != nullptr)
+        listing->names.erase(nameKey(name, key, listing->fold));
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void DirNames::renamed(const lstring& dir, const lstring& oldName, const lstring& newName) {
+    Listing* listing = findListing(dir);
+    std::string key;
+    if (listing != nullptr) {
+        listing->names.erase(nameKey(oldName, key, listing->fold));
+        listing->names.insert(nameKey(newName, key, listing->fold));
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void DirNames::forget(const lstring& dir) {
+    if (listings.erase(dir) != 0) {
+        auto iter = std::find(scanOrder.begin(), scanOrder.end(), dir);
+        if (iter != scanOrder.end())
+            scanOrder.erase(iter);
+    }
+    caseModes.erase(dir);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+DirNames::CaseMode DirNames::caseMode(const lstring& dir) {
+    auto iter = listings.find(dir);
+    return findCaseMode(dir, (iter != listings.end() && !iter->second.ready) ? &iter->second.scanned : nullptr);
+}
@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------------------------------------
+// File: dirnames.hpp
+// Author: Dennis Lang
+//
+// Desc: Cached directory listings to test rename targets without system calls
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Names of recently scanned directories. Dirscan hands over the full listing it read, so
+// "does the rename target exist" is answered from memory instead of an access() call.
+// The listing is updated as renames are applied. When unsure (directory not cached, or a
+// background move still pending) it reports the name as existing or unknown, never as free,
+// so a stale entry can cause a false EEXIST but never an overwrite.
+//
+// Case sensitivity is detected once per directory, on first use, and a case folding
+// directory keys its listing by lower case name so "a.txt" and "A.TXT" collide.
+// Only used by the main thread.
+class DirNames {
+public:
+    enum Found { UNKNOWN = -1, NO = 0, YES = 1 };
+    enum CaseMode {
+        EXACT,      // case sensitive
+        FOLD,       // case insensitive, case only rename done in place
+        FOLD_HOP    // case insensitive, case only rename ignored by filesystem, rename via temp name
+    };
+
+    static bool enabled;
+    static bool ignoreCase;             // default when case sensitivity can not be detected
+    static const size_t DIR_MAX = 64;   // directories kept, oldest dropped first
+
+    // Full listing of dir (all entry names, files and subdirectories).
+    static void scanned(const lstring& dir, std::vector<lstring>&& names);
+
+    static Found exists(const lstring& dir, const lstring& name);
+    static void added(const lstring& dir, const lstring& name);
+    static void removed(const lstring& dir, const lstring& name);
+    static void renamed(const lstring& dir, const lstring& oldName, const lstring& newName);
+
+    // Drop listing, used when the directory itself is renamed.
+    static void forget(const lstring& dir);
+
+    static CaseMode caseMode(const lstring& dir);
+};
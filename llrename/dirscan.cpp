@@ -34,63 +34,51 @@
 
 
 #include "ll_stdhdr.hpp"
-#include "signals.hpp"
 #include "dirscan.hpp"
-#include "directory.hpp"
+#include "dirnames.hpp"
 
 #include <iostream>
 
 // ---------------------------------------------------------------------------
-// Return true if inName matches pattern in patternList
-static bool FileMatches(const lstring& inName, const PatternList& patternList, bool emptyResult) {
-    if (patternList.empty() || inName.empty())
+// [static] Return true if inName matches pattern in patternList
+bool DirscanBase::FileMatches(const char* inBeg, const char* inEnd, const PatternList& patternList, bool emptyResult) {
+    if (patternList.empty() || inBeg == inEnd)
         return emptyResult;
 
-    for (size_t idx = 0; idx != patternList.size(); idx++)
-        if (std::regex_match(inName.begin(), inName.end(), patternList[idx]))
+    Stats::Timer timer(Stats::FILTER);
+    for (size_t idx = 0; idx != patternList.size(); idx++) {
+        Stats::add(Stats::PATTERN_EVALS);
+        if (std::regex_match(inBeg, inEnd, patternList[idx]))
             return true;
+    }
 
     return false;
 }
 
 // ---------------------------------------------------------------------------
-// Locate matching files which are not in exclude list.
-size_t Dirscan::FindFile(const lstring& fullname) {
-    size_t fileCount = 0;
-    lstring name;
-    DirUtil::getName(name, fullname);
-
-    if (! name.empty()
-        && ! FileMatches(name, excludeFilePatList, false)
-        && FileMatches(name, includeFilePatList, true)) {
-        if (parseFile(fullname, name))  {
-            fileCount++;
-        }
-    }
-
-    return fileCount;
+// [static]
+bool DirscanBase::FileMatches(const lstring& inName, const PatternList& patternList, bool emptyResult) {
+    return FileMatches(inName.c_str(), inName.c_str() + inName.length(), patternList, emptyResult);
 }
 
 // ---------------------------------------------------------------------------
-// Recurse over directories, locate files.
-size_t Dirscan::FindFiles(const lstring& dirname, unsigned depth) {
-    Directory_files directory(dirname);
+// Classify scan argument, regular file, directory to scan or skip.
+DirscanBase::DirKind DirscanBase::checkDir(const lstring& dirname, unsigned depth) {
     lstring fullname;
-    size_t fileCount = 0;
-    bool isDir = false;
+    DirKind kind = DIR_SKIPPED;
 
     struct stat filestat;
     try {
+        Stats::add(Stats::SYS_STAT);
         if (stat(dirname, &filestat) == 0) {
             if (S_ISREG(filestat.st_mode)) {
-                fileCount += FindFile(dirname);
-                return fileCount;
+                return IS_FILE;
             } else if (S_ISDIR(filestat.st_mode)) {
                 if ((maxDepth == 0 || depth < maxDepth)
                         && ! FileMatches(fullname, excludeDirPatList, false)
                         && FileMatches(fullname, includeDirPatList, true)) {
-                    isDir = true;
-                    parseDir(dirname, true);
+                    kind = IS_DIR;
+                    Stats::add(Stats::DIRS);
                 }
             }
         } else {
@@ -99,32 +87,55 @@ size_t Dirscan::FindFiles(const lstring& dirname, unsigned depth) {
             char CWD_BUF[256];
             getcwd(CWD_BUF, sizeof(CWD_BUF));
             std::cerr << "Unable to scan directory:" << CWD_BUF << " " << dirname << std::endl;
-            return 0;
+            return NOT_FOUND;
 #endif
         }
     }  catch (exception ex)  {
         // Probably a pattern, let directory scan do its magic.
         cerr << ex.what() << std::endl;
     }
+    return kind;
+}
 
+// ---------------------------------------------------------------------------
+// Read listing into the path tree as children of dirNode, adding a root node
+// if dirNode is NONE. Returns first entry node.
+PathTree::Node DirscanBase::readDir(Directory_files& directory, bool cacheNames, PathTree::Node& dirNode) {
+    lstring fullname;
+    PathTree::Node firstNode = (PathTree::Node)paths.size();
     while (!Signals::aborted && directory.more()) {
-        directory.fullName(fullname);
-        if (directory.is_directory()) {
-            if ((maxDepth == 0 || depth < maxDepth)
-                    && ! FileMatches(fullname, excludeDirPatList, false)
-                    && FileMatches(fullname, includeDirPatList, true)) {
-                if (recurse) {
-                    fileCount += FindFiles(fullname, depth + 1);
-                }
-                parseDir(fullname, false);
-            }
-        } else if (fullname.length() > 0) {
-            fileCount += FindFile(fullname);
+        if (dirNode == PathTree::NONE) {
+            lstring baseDir;
+            DirUtil::getDir(baseDir, directory.fullName(fullname));
+            dirNode = paths.add(PathTree::NONE, baseDir, baseDir.length(), true);
+            firstNode = dirNode + 1;
         }
+        const char* name = directory.name();
+        paths.add(dirNode, name, strlen(name), directory.is_directory());
+    }
+
+    PathTree::Node endNode = (PathTree::Node)paths.size();
+    if (cacheNames && firstNode < endNode && !Signals::aborted && DirNames::enabled) {
+        std::vector<lstring> names;
+        names.reserve(endNode - firstNode);
+        for (PathTree::Node node = firstNode; node < endNode; node++)
+            names.push_back(lstring(paths.name(node), paths.nameLen(node)));
+        DirNames::scanned(paths.path(dirNode, fullname), std::move(names));
     }
+    return firstNode;
+}
 
-    if (isDir)
-        parseDir(dirname, false);
-    return fileCount;
+// ---------------------------------------------------------------------------
+// [static]
+void DirscanBase::countEntry() {
+    Stats::add(Stats::ENTRIES);
+    Progress::inc(Progress::scanned);
 }
 
+// ---------------------------------------------------------------------------
+// [static] Stat file for a visitor which wants it, infoPtr stays nullptr on failure.
+void DirscanBase::statEntry(const DirEntry& entry, lstring& path, struct stat& info, const struct stat*& infoPtr) {
+    Stats::add(Stats::SYS_STAT);
+    if (stat(entry.path(path), &info) == 0)
+        infoPtr = &info;
+}
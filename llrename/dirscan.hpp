@@ -35,8 +35,16 @@
 #pragma once
 
 #include "ll_stdhdr.hpp"
+#include "pathtree.hpp"
+#include "sortorder.hpp"
+#include "numscope.hpp"
+#include "directory.hpp"
+#include "signals.hpp"
+#include "stats.hpp"
+#include "progress.hpp"
 
 #include <regex>
+#include <string_view>
 
 #ifdef HAVE_WIN
 #endif
@@ -45,25 +53,214 @@ typedef std::vector<std::regex> PatternList;
 typedef bool (*ParseDir_t)(const lstring& filepath, bool onEntry);
 typedef bool (*ParseFile_t)(const lstring& filepath, const lstring& filename);
 
-class Dirscan {
-    ParseDir_t parseDir;
-    ParseFile_t parseFile;
-    
+//-------------------------------------------------------------------------------------------------
+// Entry handed to a Dirscan visitor, only valid during the callback.
+// Files are a tree node plus name, the full path is built by path() when needed.
+struct DirEntry {
+    const PathTree* tree;
+    PathTree::Node node;        // NONE if fullPath is set
+    const lstring* fullPath;    // directories and file arguments
+    std::string_view name;
+    bool isDir;
+    unsigned depth;
+    const struct stat* info;    // only if Visitor::WANT_STAT, else nullptr
+
+    const lstring& path(lstring& outPath) const {
+        return (fullPath != nullptr) ? *fullPath : tree->path(node, outPath);
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+// Filters, options and the parts of a scan which do not depend on the visitor.
+class DirscanBase {
 public:
     bool recurse = false;
-    
-public:
-    Dirscan(ParseDir_t _parseDir, ParseFile_t _parseFile) : parseDir(_parseDir), parseFile(_parseFile) {
-    }
-    // ~Dirscan();
-    
+    SortOrder::By sortBy = SortOrder::NONE;     // NONE is readdir order
+
     PatternList includeFilePatList;
     PatternList excludeFilePatList;
     PatternList includeDirPatList;
     PatternList excludeDirPatList;
     unsigned maxDepth = 0;  // 0 no limit
-    
-    size_t FindFile(const lstring& dirname);
-    size_t FindFiles(const lstring& dirname, unsigned depth);
+
+    static bool FileMatches(const char* inBeg, const char* inEnd, const PatternList& patternList, bool emptyResult);
+    static bool FileMatches(const lstring& inName, const PatternList& patternList, bool emptyResult);
+
+protected:
+    enum DirKind { IS_FILE, IS_DIR, DIR_SKIPPED, NOT_FOUND };
+    DirKind checkDir(const lstring& dirname, unsigned depth);
+    bool dirMatches(const lstring& fullname, unsigned depth) const {
+        return (maxDepth == 0 || depth < maxDepth)
+            && ! FileMatches(fullname, excludeDirPatList, false)
+            && FileMatches(fullname, includeDirPatList, true);
+    }
+    bool fileMatches(std::string_view name) const {
+        return ! name.empty()
+            && ! FileMatches(name.data(), name.data() + name.size(), excludeFilePatList, false)
+            && FileMatches(name.data(), name.data() + name.size(), includeFilePatList, true);
+    }
+    PathTree::Node readDir(Directory_files& directory, bool cacheNames, PathTree::Node& dirNode);
+    static void countEntry();
+    static void statEntry(const DirEntry& entry, lstring& path, struct stat& info, const struct stat*& infoPtr);
+
+    PathTree paths;         // entries of directories being scanned
+};
+
+//-------------------------------------------------------------------------------------------------
+// Directory scanner calling a visitor, which is inlined at compile time:
+//   struct Visitor {
+//       static const bool WANT_STAT = false;     // true to get DirEntry::info for files
+//       bool onDir(const DirEntry& entry, bool onEntry);
+//       bool onFile(const DirEntry& entry);      // true counts the file
+//   };
+template <class Visitor>
+class DirscanT : public DirscanBase {
+public:
+    Visitor visitor;
+
+    DirscanT(const Visitor& _visitor) : visitor(_visitor) {
+    }
+
+    size_t FindFile(const lstring& fullname);
+    size_t FindFiles(const lstring& dirname, unsigned depth, PathTree::Node dirNode = PathTree::NONE);
+
+private:
+    lstring statPath;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Adapter for the full path callbacks, builds path and name strings per entry.
+class PathVisitor {
+    ParseDir_t parseDir;
+    ParseFile_t parseFile;
+    lstring filePath;
+    lstring fileName;
+
+public:
+    static const bool WANT_STAT = false;
+
+    PathVisitor(ParseDir_t _parseDir, ParseFile_t _parseFile) : parseDir(_parseDir), parseFile(_parseFile) {
+    }
+    bool onDir(const DirEntry& entry, bool onEntry) {
+        return parseDir(entry.path(filePath), onEntry);
+    }
+    bool onFile(const DirEntry& entry) {
+        fileName.assign(entry.name.data(), entry.name.size());
+        return parseFile(entry.path(filePath), fileName);
+    }
 };
 
+class Dirscan : public DirscanT<PathVisitor> {
+public:
+    Dirscan(ParseDir_t _parseDir, ParseFile_t _parseFile) : DirscanT<PathVisitor>(PathVisitor(_parseDir, _parseFile)) {
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Locate matching files which are not in exclude list.
+template <class Visitor>
+size_t DirscanT<Visitor>::FindFile(const lstring& fullname) {
+    size_t nameStart = fullname.rfind(Directory_files::SLASH_CHAR);
+    std::string_view name(fullname.c_str(), fullname.length());
+    if (nameStart != std::string::npos)
+        name.remove_prefix(nameStart + 1);
+
+    if (fileMatches(name)) {
+        Progress::inc(Progress::matched);
+        if (NumScope::scope != NumScope::SERIAL)
+            NumScope::reserve(fullname.view());
+        DirEntry entry { &paths, PathTree::NONE, &fullname, name, false, 0, nullptr };
+        struct stat info;
+        if (Visitor::WANT_STAT)
+            statEntry(entry, statPath, info, entry.info);
+        if (visitor.onFile(entry))
+            return 1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Recurse over directories, locate files.
+// dirNode is the tree node of dirname when called for a subdirectory.
+template <class Visitor>
+size_t DirscanT<Visitor>::FindFiles(const lstring& dirname, unsigned depth, PathTree::Node dirNode) {
+    Stats::Timer timer(Stats::SCAN);
+    Directory_files directory(dirname);
+    size_t fileCount = 0;
+
+    DirKind kind = checkDir(dirname, depth);
+    if (kind == IS_FILE)
+        return FindFile(dirname);
+    if (kind == NOT_FOUND)
+        return 0;
+
+    bool isDir = (kind == IS_DIR);
+    size_t nameStart = dirname.rfind(Directory_files::SLASH_CHAR);
+    std::string_view dirName(dirname.c_str(), dirname.length());
+    if (nameStart != std::string::npos)
+        dirName.remove_prefix(nameStart + 1);
+    DirEntry dirEntry { &paths, PathTree::NONE, &dirname, dirName, true, depth, nullptr };
+    if (isDir)
+        visitor.onDir(dirEntry, true);
+
+    // Read full listing before handling any entry, so renames in this directory are not
+    // returned again by readdir and the name cache knows every existing target.
+    // Entries are name spans in the path tree, released when this directory is done.
+    PathTree::Mark mark = paths.mark();
+    PathTree::Node firstNode = readDir(directory, isDir, dirNode);
+    PathTree::Node endNode = (PathTree::Node)paths.size();
+    std::vector<PathTree::Node> order;
+    if (sortBy != SortOrder::NONE && firstNode < endNode)
+        SortOrder::sort(sortBy, paths, firstNode, endNode, order);
+
+    // Numbering scopes need the matched file count before the first file is handled.
+    // Numbers stay with this directory, subdirectories scanned first reserve their own.
+    std::vector<char> matches;
+    std::vector<unsigned> fileNums;
+    size_t fileIdx = 0;
+    if (NumScope::scope != NumScope::SERIAL) {
+        std::vector<PathTree::Node> files;
+        matches.resize(endNode - firstNode);
+        for (size_t idx = 0; firstNode + idx < endNode; idx++) {
+            PathTree::Node node = order.empty() ? firstNode + (PathTree::Node)idx : order[idx];
+            matches[idx] = !paths.isDir(node) && fileMatches(std::string_view(paths.name(node), paths.nameLen(node)));
+            if (matches[idx])
+                files.push_back(node);
+        }
+        NumScope::reserve(paths, files, fileNums);
+    }
+
+    lstring fullname;
+    struct stat info;
+    for (size_t idx = 0; firstNode + idx < endNode && !Signals::aborted; idx++) {
+        PathTree::Node node = order.empty() ? firstNode + (PathTree::Node)idx : order[idx];
+        countEntry();
+        std::string_view name(paths.name(node), paths.nameLen(node));
+        if (paths.isDir(node)) {
+            paths.path(node, fullname);
+            if (dirMatches(fullname, depth)) {
+                // A recursed directory reports its own exit, report each exit once.
+                if (recurse) {
+                    fileCount += FindFiles(fullname, depth + 1, node);
+                } else {
+                    DirEntry entry { &paths, PathTree::NONE, &fullname, name, true, depth + 1, nullptr };
+                    visitor.onDir(entry, false);
+                }
+            }
+        } else if (matches.empty() ? fileMatches(name) : matches[idx] != 0) {
+            Progress::inc(Progress::matched);
+            DirEntry entry { &paths, node, nullptr, name, false, depth + 1, nullptr };
+            if (Visitor::WANT_STAT)
+                statEntry(entry, statPath, info, entry.info);
+            if (fileIdx < fileNums.size())
+                NumScope::queue(fileNums[fileIdx++]);
+            if (visitor.onFile(entry))
+                fileCount++;
+        }
+    }
+    paths.release(mark);
+
+    if (isDir)
+        visitor.onDir(dirEntry, false);
+    return fileCount;
+}
@@ -0,0 +1,136 @@
+//-------------------------------------------------------------------------------------------------
+// File: errors.cpp
+// Author: Dennis Lang
+//
+// Desc: Aggregate and rate limit rename error messages
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "errors.hpp"
+#include "parseutil.hpp"
+
+#include <fstream>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <time.h>
+
+unsigned Errors::sampleCnt = 10;
+bool Errors::showAll = false;
+
+struct ErrorGroup {
+    size_t shown = 0;
+    size_t suppressed = 0;      // since last sample
+    size_t total = 0;
+};
+
+static std::mutex errMutex;
+static std::map<int, ErrorGroup> byErrno;
+static std::map<std::pair<int, lstring>, size_t> byDir;
+static time_t lastSample = 0;
+static size_t errTotal = 0;
+
+static std::ofstream logStream;
+static lstring logPath;
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool Errors::openLog(const char* path) {
+    logStream.open(path, std::ios::out | std::ios::trunc);
+    logPath = path;
+    return logStream.good();
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+size_t Errors::count() {
+    std::lock_guard<std::mutex> lock(errMutex);
+    return errTotal;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Record failure, show message unless rate limited.
+void Errors::add(int err, const char* action, const char* dir, const char* oldName, const char* newName) {
+    std::lock_guard<std::mutex> lock(errMutex);
+    errTotal++;
+    byDir[std::make_pair(err, lstring(dir))]++;
+
+    if (logStream.is_open()) {
+        logStream << strerror(err) << action << oldName << " to " << newName << "\n";
+    }
+
+    ErrorGroup& group = byErrno[err];
+    group.total++;
+    time_t now = time(nullptr);
+    if (showAll || group.shown < sampleCnt || now != lastSample) {
+        if (group.shown >= sampleCnt)
+            lastSample = now;
+        if (group.suppressed != 0) {
+            Colors::showError(" ...", group.suppressed, "similar errors suppressed:", strerror(err));
+            group.suppressed = 0;
+        }
+        Colors::showError(strerror(err), action, oldName, "\n     to ", newName);
+        group.shown++;
+    } else {
+        group.suppressed++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Show counts by errno and the directories with the most failures.
+void Errors::report(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(errMutex);
+    if (logStream.is_open()) {
+        logStream.close();
+        if (errTotal != 0)
+            out << "Error details in " << logPath << std::endl;
+    }
+    if (errTotal == 0 || errTotal <= sampleCnt)
+        return;
+
+    out << "--- Errors ---\n";
+    for (auto& item : byErrno) {
+        out << item.second.total << "  " << strerror(item.first)
+            << " (shown " << item.second.shown << ")\n";
+    }
+
+    const size_t TOP_DIRS = 10;
+    std::vector<std::pair<size_t, const std::pair<int, lstring>*>> dirs;
+    for (auto& item : byDir)
+        dirs.push_back(std::make_pair(item.second, &item.first));
+    size_t topCnt = std::min(TOP_DIRS, dirs.size());
+    std::partial_sort(dirs.begin(), dirs.begin() + topCnt, dirs.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+    for (size_t idx = 0; idx < topCnt; idx++) {
+        out << dirs[idx].first << "  " << strerror(dirs[idx].second->first)
+            << " in " << dirs[idx].second->second << "\n";
+    }
+    out << "--- End Errors ---\n";
+}
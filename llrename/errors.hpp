@@ -0,0 +1,58 @@
+//-------------------------------------------------------------------------------------------------
+// File: errors.hpp
+// Author: Dennis Lang
+//
+// Desc: Aggregate and rate limit rename error messages
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <iostream>
+
+//-------------------------------------------------------------------------------------------------
+// Failures are counted by errno and directory. The first few of each errno are shown,
+// after that at most one sample per second. Every failure is written to the optional
+// error log (-errorLog) and a grouped summary is shown at the end of the run.
+class Errors {
+public:
+    static unsigned sampleCnt;      // Samples shown per errno before rate limiting
+    static bool showAll;            // Disable rate limit (-verbose)
+
+    // Open detail log, return false if open fails.
+    static bool openLog(const char* path);
+
+    static void add(int err, const char* action, const char* dir, const char* oldName, const char* newName);
+    static size_t count();
+
+    // Show grouped summary and close detail log.
+    static void report(std::ostream& out);
+};
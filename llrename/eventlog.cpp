@@ -0,0 +1,155 @@
+//-------------------------------------------------------------------------------------------------
+// File: eventlog.cpp
+// Author: Dennis Lang
+//
+// Desc: NDJSON event stream of planned, applied and failed renames (-json)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "eventlog.hpp"
+
+#include <mutex>
+
+bool EventLog::enabled = false;
+
+static const size_t BUF_SIZE = 1 << 20;
+static char* buffer = nullptr;
+static size_t bufLen = 0;
+static FILE* outFile = nullptr;
+static std::mutex logMutex;
+
+static const char* EVENT_NAMES[] = { "plan", "apply", "fail" };
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool EventLog::open(const char* path) {
+    close();
+    outFile = (strcmp(path, "-") == 0) ? stdout : fopen(path, "wb");
+    if (outFile == nullptr)
+        return false;
+    buffer = new char[BUF_SIZE];
+    bufLen = 0;
+    enabled = true;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool EventLog::toStdout() {
+    return outFile == stdout;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void EventLog::close() {
+    flush();
+    if (outFile != nullptr) {
+        if (outFile != stdout)
+            fclose(outFile);
+        outFile = nullptr;
+        delete[] buffer;
+        buffer = nullptr;
+    }
+    enabled = false;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void EventLog::flush() {
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (outFile != nullptr && bufLen != 0) {
+        fwrite(buffer, 1, bufLen, outFile);
+        fflush(outFile);
+        bufLen = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void EventLog::append(const char* str, size_t len) {
+    if (bufLen + len > BUF_SIZE) {
+        fwrite(buffer, 1, bufLen, outFile);
+        bufLen = 0;
+        if (len > BUF_SIZE) {
+            fwrite(str, 1, len, outFile);
+            return;
+        }
+    }
+    memcpy(buffer + bufLen, str, len);
+    bufLen += len;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Append quoted json string, escape quote, backslash and control characters.
+void EventLog::appendJson(const char* str) {
+    static const char HEX[] = "0123456789abcdef";
+    append("\"", 1);
+    const char* run = str;
+    for (; *str; str++) {
+        unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\' || c < 0x20) {
+            append(run, str - run);
+            char esc[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xf] };
+            if (c == '"' || c == '\\') {
+                esc[1] = (char)c;
+                append(esc, 2);
+            } else {
+                append(esc, 6);
+            }
+            run = str + 1;
+        }
+    }
+    append(run, str - run);
+    append("\"", 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void EventLog::write(Event event, const char* oldName, const char* newName, int err, uint64_t nanoSec) {
+    if (!enabled)
+        return;
+
+    char numBuf[80];
+    std::lock_guard<std::mutex> lock(logMutex);
+    int len = snprintf(numBuf, sizeof(numBuf), "{\"ev\":\"%s\",\"old\":", EVENT_NAMES[event]);
+    append(numBuf, len);
+    appendJson(oldName);
+    append(",\"new\":", 7);
+    appendJson(newName);
+    if (event == FAIL) {
+        len = snprintf(numBuf, sizeof(numBuf), ",\"errno\":%d,\"err\":", err);
+        append(numBuf, len);
+        appendJson(strerror(err));
+    }
+    if (event != PLAN) {
+        len = snprintf(numBuf, sizeof(numBuf), ",\"us\":%llu", (unsigned long long)(nanoSec / 1000));
+        append(numBuf, len);
+    }
+    append("}\n", 2);
+}
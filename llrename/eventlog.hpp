@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------------------------
+// File: eventlog.hpp
+// Author: Dennis Lang
+//
+// Desc: NDJSON event stream of planned, applied and failed renames (-json)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// One compact json record per line, for example:
+//   {"ev":"apply","old":"dir/a.txt","new":"dir/b.txt","us":12}
+//   {"ev":"fail","old":"dir/c.txt","new":"dir/d.txt","errno":17,"err":"File exists","us":9}
+// Records are appended to a large in-memory buffer which is written with fwrite when full.
+class EventLog {
+public:
+    enum Event { PLAN, APPLY, FAIL };
+
+    static bool enabled;
+
+    // Open output file, "-" is stdout. Return false if open fails.
+    static bool open(const char* path);
+    static bool toStdout();         // opened as "-"
+    static void close();
+    static void flush();
+
+    static void write(Event event, const char* oldName, const char* newName, int err = 0, uint64_t nanoSec = 0);
+
+private:
+    static void append(const char* str, size_t len);
+    static void appendJson(const char* str);
+};
@@ -0,0 +1,175 @@
+//-------------------------------------------------------------------------------------------------
+// File: exif.cpp
+// Author: Dennis Lang
+//
+// Desc: Read EXIF capture date from image header
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "exif.hpp"
+#include "stats.hpp"
+#include "filemeta.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+static const uint16_t TAG_DATETIME = 0x0132;
+static const uint16_t TAG_EXIF_IFD = 0x8769;
+static const uint16_t TAG_DATETIME_ORIGINAL = 0x9003;
+static const uint16_t TYPE_ASCII = 2;
+
+// Bounds checked reader over TIFF structure, offsets relative to TIFF header.
+struct TiffReader {
+    const unsigned char* base;
+    size_t len;
+    bool bigEndian;
+
+    bool get16(size_t off, uint16_t& val) const {
+        if (off + 2 > len)
+            return false;
+        val = bigEndian ? (uint16_t)(base[off] << 8 | base[off + 1]) : (uint16_t)(base[off + 1] << 8 | base[off]);
+        return true;
+    }
+    bool get32(size_t off, uint32_t& val) const {
+        if (off + 4 > len)
+            return false;
+        const unsigned char* ptr = base + off;
+        val = bigEndian ? ((uint32_t)ptr[0] << 24 | (uint32_t)ptr[1] << 16 | (uint32_t)ptr[2] << 8 | ptr[3])
+            : ((uint32_t)ptr[3] << 24 | (uint32_t)ptr[2] << 16 | (uint32_t)ptr[1] << 8 | ptr[0]);
+        return true;
+    }
+
+    // Find tag in IFD at offset, return offset of its 4 byte value field.
+    bool findTag(size_t ifdOff, uint16_t tag, uint16_t& type, uint32_t& count, size_t& valueOff) const {
+        uint16_t entries;
+        if (!get16(ifdOff, entries))
+            return false;
+        for (unsigned idx = 0; idx < entries; idx++) {
+            size_t entryOff = ifdOff + 2 + idx * 12;
+            uint16_t entryTag;
+            if (!get16(entryOff, entryTag) || !get16(entryOff + 2, type) || !get32(entryOff + 4, count))
+                return false;
+            if (entryTag == tag) {
+                valueOff = entryOff + 8;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Parse "YYYY:MM:DD HH:MM:SS" ascii tag.
+    bool getDate(size_t ifdOff, uint16_t tag, time_t& outTime) const {
+        uint16_t type;
+        uint32_t count, dataOff;
+        size_t valueOff;
+        if (!findTag(ifdOff, tag, type, count, valueOff) || type != TYPE_ASCII || count < 19)
+            return false;
+        if (!get32(valueOff, dataOff) || dataOff + 19 > len)
+            return false;
+
+        struct tm tmTime;
+        memset(&tmTime, 0, sizeof(tmTime));
+        const char* str = (const char*)base + dataOff;
+        if (sscanf(str, "%4d:%2d:%2d %2d:%2d:%2d", &tmTime.tm_year, &tmTime.tm_mon, &tmTime.tm_mday,
+                &tmTime.tm_hour, &tmTime.tm_min, &tmTime.tm_sec) != 6 || tmTime.tm_year < 1900)
+            return false;
+        tmTime.tm_year -= 1900;
+        tmTime.tm_mon -= 1;
+        tmTime.tm_isdst = -1;
+        outTime = mktime(&tmTime);
+        return outTime != (time_t)-1;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+static bool tiffCaptureTime(const unsigned char* data, size_t len, time_t& outTime) {
+    if (len < 8)
+        return false;
+    TiffReader tiff = { data, len, data[0] == 'M' };
+    uint16_t magic;
+    uint32_t ifd0;
+    if ((data[0] != 'I' && data[0] != 'M') || data[1] != data[0]
+            || !tiff.get16(2, magic) || magic != 42 || !tiff.get32(4, ifd0))
+        return false;
+
+    uint16_t type;
+    uint32_t count, exifIfd;
+    size_t valueOff;
+    if (tiff.findTag(ifd0, TAG_EXIF_IFD, type, count, valueOff) && tiff.get32(valueOff, exifIfd)
+            && tiff.getDate(exifIfd, TAG_DATETIME_ORIGINAL, outTime))
+        return true;
+    return tiff.getDate(ifd0, TAG_DATETIME, outTime);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool Exif::captureTime(const unsigned char* data, size_t len, time_t& outTime) {
+    if (len >= 4 && data[0] == 0xFF && data[1] == 0xD8) {
+        // JPEG, walk markers to APP1 "Exif\0\0".
+        size_t off = 2;
+        while (off + 4 <= len && data[off] == 0xFF) {
+            unsigned char marker = data[off + 1];
+            size_t segLen = (size_t)data[off + 2] << 8 | data[off + 3];
+            if (marker == 0xDA || marker == 0xD9 || segLen < 2)
+                break;      // start of scan, no more metadata
+            if (marker == 0xE1 && off + 10 <= len && memcmp(data + off + 4, "Exif\0\0", 6) == 0) {
+                size_t tiffOff = off + 10;
+                size_t tiffLen = std::min(segLen - 8, len - tiffOff);
+                return tiffCaptureTime(data + tiffOff, tiffLen, outTime);
+            }
+            off += 2 + segLen;
+        }
+        return false;
+    }
+    return tiffCaptureTime(data, len, outTime);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool Exif::captureTime(const char* path, time_t& outTime) {
+    FILE* file = FileMeta::openRead(path);
+    if (file == nullptr)
+        return false;
+
+    // Small first read covers most JPEG, re-read up to HEADER_MAX only if needed.
+    std::vector<unsigned char> buf(16 * 1024);
+    size_t len = fread(buf.data(), 1, buf.size(), file);
+    bool found = captureTime(buf.data(), len, outTime);
+    bool knownFormat = len >= 2 && ((buf[0] == 0xFF && buf[1] == 0xD8) || (buf[0] == buf[1] && (buf[0] == 'I' || buf[0] == 'M')));
+    if (!found && knownFormat && len == buf.size()) {
+        buf.resize(HEADER_MAX);
+        len += fread(buf.data() + len, 1, buf.size() - len, file);
+        found = captureTime(buf.data(), len, outTime);
+    }
+    Stats::add(Stats::BYTES_READ, len);
+    fclose(file);
+    return found;
+}
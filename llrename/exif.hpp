@@ -0,0 +1,51 @@
+//-------------------------------------------------------------------------------------------------
+// File: exif.hpp
+// Author: Dennis Lang
+//
+// Desc: Read EXIF capture date from image header
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <time.h>
+
+//-------------------------------------------------------------------------------------------------
+// Minimal EXIF reader, only the capture date. Reads at most HEADER_MAX bytes, handles
+// JPEG (APP1 Exif segment) and TIFF based raw files (tiff, dng, nef, cr2, arw).
+class Exif {
+public:
+    static const size_t HEADER_MAX = 128 * 1024;
+
+    // DateTimeOriginal, else DateTime, as local time. False if file has none.
+    static bool captureTime(const char* path, time_t& outTime);
+    static bool captureTime(const unsigned char* data, size_t len, time_t& outTime);
+};
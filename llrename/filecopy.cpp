@@ -0,0 +1,313 @@
+//-------------------------------------------------------------------------------------------------
+// File: filecopy.cpp
+// Author: Dennis Lang
+//
+// Desc: Copy file data, sharing blocks when the filesystem can
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "filecopy.hpp"
+#include "stats.hpp"
+#include "filemeta.hpp"
+#include "directory.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include <memory>
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+
+#ifdef HAVE_WIN
+#include <io.h>
+#include <direct.h>
+#define read _read
+#define close _close
+#define mkdir(path, mode) _mkdir(path)
+#else
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/syscall.h>
+#endif
+#ifdef __APPLE__
+#include <sys/clonefile.h>
+#endif
+
+#ifndef EOPNOTSUPP
+#define EOPNOTSUPP ENOTSUP
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool FileCopy::clone(const char* srcPath, const char* dstPath) {
+#if defined(__APPLE__)
+    Stats::add(Stats::SYS_OPEN);
+    return clonefile(srcPath, dstPath, 0) == 0;
+#elif defined(FICLONE)
+    Stats::add(Stats::SYS_OPEN);
+    int srcFd = open(srcPath, O_RDONLY);
+    if (srcFd < 0)
+        return false;
+    struct stat info;
+    int dstFd = -1;
+    if (fstat(srcFd, &info) == 0) {
+        Stats::add(Stats::SYS_OPEN);
+        dstFd = open(dstPath, O_WRONLY | O_CREAT | O_EXCL, info.st_mode & 07777);
+    }
+    bool okay = dstFd >= 0 && ioctl(dstFd, FICLONE, srcFd) == 0;
+    int err = errno;
+    if (dstFd >= 0) {
+        close(dstFd);
+        if (!okay)
+            unlink(dstPath);
+    }
+    close(srcFd);
+    errno = err;
+    return okay;
+#else
+    errno = EOPNOTSUPP;
+    return false;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool FileCopy::sameContent(const char* path1, const char* path2) {
+    static const size_t BUF_SIZE = 1 << 20;
+    int fd1 = FileMeta::openFd(path1);
+    int fd2 = FileMeta::openFd(path2);
+    bool same = fd1 >= 0 && fd2 >= 0;
+    if (same) {
+        std::unique_ptr<unsigned char[]> buf1(new unsigned char[BUF_SIZE]);
+        std::unique_ptr<unsigned char[]> buf2(new unsigned char[BUF_SIZE]);
+        for (;;) {
+            auto len1 = read(fd1, buf1.get(), BUF_SIZE);
+            auto len2 = (len1 > 0) ? read(fd2, buf2.get(), (unsigned)len1) : read(fd2, buf2.get(), 1);
+            if (len1 != len2 || len1 < 0) {
+                same = false;
+                break;
+            }
+            if (len1 == 0)
+                break;
+            Stats::add(Stats::BYTES_READ, 2 * (uint64_t)len1);
+            if (memcmp(buf1.get(), buf2.get(), (size_t)len1) != 0) {
+                same = false;
+                break;
+            }
+        }
+    }
+    if (fd1 >= 0)
+        close(fd1);
+    if (fd2 >= 0)
+        close(fd2);
+    return same;
+}
+
+#ifndef HAVE_WIN
+//-------------------------------------------------------------------------------------------------
+// Write all of buffer, false on error.
+static bool writeAll(int fd, const unsigned char* buf, size_t len) {
+    while (len != 0) {
+        ssize_t done = write(fd, buf, len);
+        if (done < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        buf += done;
+        len -= (size_t)done;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Copy data with copy_file_range. Sets fallback if nothing was copied because the
+// kernel or filesystem pair can not, caller then uses read/write.
+static bool kernelCopy(int srcFd, int dstFd, uint64_t size, bool& fallback) {
+    fallback = false;
+#if defined(__linux__) && defined(SYS_copy_file_range)
+    uint64_t copied = 0;
+    while (copied < size) {
+        ssize_t done = syscall(SYS_copy_file_range, srcFd, nullptr, dstFd, nullptr,
+            (size_t)std::min(size - copied, (uint64_t)1 << 30), 0);
+        if (done < 0) {
+            if (errno == EINTR)
+                continue;
+            fallback = (copied == 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP));
+            return false;
+        }
+        if (done == 0)
+            break;      // file shrank
+        copied += (uint64_t)done;
+    }
+    Stats::add(Stats::BYTES_COPIED, copied);
+    return true;
+#else
+    errno = ENOSYS;
+    fallback = true;
+    return false;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+static bool bufferCopy(int srcFd, int dstFd) {
+    thread_local std::unique_ptr<unsigned char[]> buffer;
+    if (!buffer)
+        buffer.reset(new unsigned char[FileCopy::BUF_SIZE]);
+    for (;;) {
+        ssize_t len = read(srcFd, buffer.get(), FileCopy::BUF_SIZE);
+        if (len < 0 && errno == EINTR)
+            continue;
+        if (len <= 0)
+            return len == 0;
+        if (!writeAll(dstFd, buffer.get(), (size_t)len))
+            return false;
+        Stats::add(Stats::BYTES_COPIED, (uint64_t)len);
+    }
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool FileCopy::copy(const char* srcPath, const char* dstPath, Method* used, bool syncData) {
+    Method method = CLONED;
+#ifdef HAVE_WIN
+    bool okay = CopyFileA(srcPath, dstPath, TRUE) != 0;
+    if (!okay)
+        errno = (GetLastError() == ERROR_FILE_EXISTS) ? EEXIST : EIO;
+    method = BUFFER_COPY;
+#else
+#ifdef __APPLE__
+    if (clonefile(srcPath, dstPath, 0) == 0) {
+        Stats::add(Stats::CLONED);
+        if (used != nullptr)
+            *used = CLONED;
+        return true;
+    }
+#endif
+    int srcFd = FileMeta::openFd(srcPath);
+    if (srcFd < 0)
+        return false;
+    struct stat info;
+    int dstFd = -1;
+    if (fstat(srcFd, &info) == 0) {
+        Stats::add(Stats::SYS_OPEN);
+        dstFd = open(dstPath, O_WRONLY | O_CREAT | O_EXCL, info.st_mode & 07777);
+    }
+    bool okay = false;
+    if (dstFd >= 0) {
+#ifdef FICLONE
+        okay = ioctl(dstFd, FICLONE, srcFd) == 0;
+#endif
+        if (okay) {
+            Stats::add(Stats::CLONED);
+        } else {
+            bool fallback;
+            method = KERNEL_COPY;
+            okay = kernelCopy(srcFd, dstFd, (uint64_t)info.st_size, fallback);
+            if (!okay && fallback) {
+                method = BUFFER_COPY;
+                okay = bufferCopy(srcFd, dstFd);
+            }
+        }
+        if (okay) {
+#ifdef __APPLE__
+            struct timespec times[2] = { info.st_atimespec, info.st_mtimespec };
+#else
+            struct timespec times[2] = { info.st_atim, info.st_mtim };
+#endif
+            futimens(dstFd, times);
+            if (syncData && fsync(dstFd) != 0)
+                okay = false;
+        }
+    }
+    int err = errno;
+    if (dstFd >= 0) {
+        if (close(dstFd) != 0 && okay) {
+            okay = false;
+            err = errno;
+        }
+        if (!okay)
+            unlink(dstPath);
+    }
+    close(srcFd);
+    errno = err;
+#endif
+    if (okay && used != nullptr)
+        *used = method;
+    return okay;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool FileCopy::move(const char* srcPath, const char* dstPath) {
+    if (!copy(srcPath, dstPath, nullptr, true))
+        return false;
+    if (remove(srcPath) != 0) {
+        int err = errno;
+        remove(dstPath);
+        errno = err;
+        return false;
+    }
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool FileCopy::makeDirs(const lstring& dir) {
+    static std::mutex dirMutex;
+    static std::unordered_set<std::string> madeDirs;
+    {
+        std::lock_guard<std::mutex> lock(dirMutex);
+        if (dir.empty() || madeDirs.count(dir) != 0)
+            return true;
+    }
+
+    struct stat info;
+    Stats::add(Stats::SYS_STAT);
+    bool okay = stat(dir, &info) == 0 && S_ISDIR(info.st_mode);
+    if (!okay) {
+        lstring parent;
+        DirUtil::getDir(parent, dir);
+        okay = (parent.length() < dir.length()) && makeDirs(parent)
+            && (mkdir(dir, 0777) == 0 || errno == EEXIST);
+    }
+    if (okay) {
+        std::lock_guard<std::mutex> lock(dirMutex);
+        madeDirs.insert(dir);
+    }
+    return okay;
+}
@@ -0,0 +1,65 @@
+//-------------------------------------------------------------------------------------------------
+// File: filecopy.hpp
+// Author: Dennis Lang
+//
+// Desc: Copy file data, sharing blocks when the filesystem can
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+//-------------------------------------------------------------------------------------------------
+// File data copies for dedup and copy modes. Paths are absolute or relative to the
+// current directory, results are false with errno set.
+class FileCopy {
+public:
+    enum Method { CLONED, KERNEL_COPY, BUFFER_COPY };
+    static const size_t BUF_SIZE = 4 << 20;    // fallback copy block
+
+    // Copy data, permissions and modify time to new file dstPath. Tries clone, then
+    // in kernel copy_file_range, then buffered read/write. Partial dstPath is removed.
+    // With syncData the copy is on disk before returning.
+    static bool copy(const char* srcPath, const char* dstPath, Method* used = nullptr, bool syncData = false);
+
+    // Move across filesystems, synced copy then delete source. On failure source is kept.
+    static bool move(const char* srcPath, const char* dstPath);
+
+    // Create directory and missing parents, remembers created directories so repeated
+    // calls for the same target cost a set lookup. Safe from worker threads.
+    static bool makeDirs(const lstring& dir);
+
+    // Create dstPath sharing data blocks with srcPath (FICLONE, clonefile).
+    // dstPath must not exist. Fails with EOPNOTSUPP or EXDEV if the filesystem can not clone.
+    static bool clone(const char* srcPath, const char* dstPath);
+
+    // Byte compare two files, false if different or unreadable.
+    static bool sameContent(const char* path1, const char* path2);
+};
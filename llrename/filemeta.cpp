@@ -0,0 +1,150 @@
+//-------------------------------------------------------------------------------------------------
+// File: filemeta.cpp
+// Author: Dennis Lang
+//
+// Desc: Per entry file metadata carried from scan to rename
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "filemeta.hpp"
+#include "stats.hpp"
+#include "exif.hpp"
+#include "hash.hpp"
+#include "hashcache.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+
+#ifdef HAVE_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+static int baseFd = AT_FDCWD;
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void FileMeta::init() {
+#ifndef HAVE_WIN
+    int fd = open(".", O_RDONLY | O_DIRECTORY);
+    if (fd >= 0)
+        baseFd = fd;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+void FileMeta::set(const struct stat& info) {
+    loaded |= bit(STAT);
+    valid = true;
+    err = 0;
+    mode = (unsigned)info.st_mode;
+    size = (uint64_t)info.st_size;
+    inode = (uint64_t)info.st_ino;
+    dev = (uint64_t)info.st_dev;
+    nlink = (unsigned)info.st_nlink;
+    mtime = info.st_mtime;
+#if defined(__APPLE__)
+    mtimeNs = info.st_mtimespec.tv_nsec;
+#elif !defined(HAVE_WIN)
+    mtimeNs = info.st_mtim.tv_nsec;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+bool FileMeta::load(const char* path) {
+    struct stat info;
+    Stats::add(Stats::SYS_STAT);
+#ifdef HAVE_WIN
+    int code = stat(path, &info);
+#else
+    int code = fstatat(baseFd, path, &info, 0);
+#endif
+    if (code == 0) {
+        set(info);
+    } else {
+        loaded |= bit(STAT);
+        valid = false;
+        err = errno;
+    }
+    return valid;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+int FileMeta::openFd(const char* path) {
+    Stats::add(Stats::SYS_OPEN);
+#ifdef HAVE_WIN
+    return _open(path, _O_RDONLY | _O_BINARY);
+#else
+    return openat(baseFd, path, O_RDONLY);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+FILE* FileMeta::openRead(const char* path) {
+#ifdef HAVE_WIN
+    Stats::add(Stats::SYS_OPEN);
+    return fopen(path, "rb");
+#else
+    int fd = openFd(path);
+    if (fd < 0)
+        return nullptr;
+    FILE* file = fdopen(fd, "rb");
+    if (file == nullptr)
+        close(fd);
+    return file;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+bool FileMeta::need(const char* path, unsigned levels) {
+    levels &= ~loaded;
+    if (levels == 0)
+        return err == 0;
+    if ((loaded & bit(STAT)) == 0)
+        load(path);
+    if (!valid)
+        return false;
+
+    if ((levels & bit(HEADER)) != 0) {
+        hasExif = S_ISREG(mode) && Exif::captureTime(path, exifTime);
+        loaded |= bit(HEADER);
+    }
+    if ((levels & bit(HASH)) != 0) {
+        if (!HashCache::enabled || !HashCache::find(*this, hash)) {
+            if (!Hash::ofFile(path, hash))
+                err = errno;
+            else if (HashCache::enabled)
+                HashCache::add(*this, hash);
+        }
+        loaded |= bit(HASH);
+    }
+    return err == 0;
+}
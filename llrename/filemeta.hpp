@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------------------------------------
+// File: filemeta.hpp
+// Author: Dennis Lang
+//
+// Desc: Per entry file metadata carried from scan to rename
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/stat.h>
+
+//-------------------------------------------------------------------------------------------------
+// Metadata of one scanned entry. Loaded by the prefetch workers, or on demand,
+// and passed along with the name to the transform stage. Each level is loaded lazily,
+// only if a rename rule references it.
+struct FileMeta {
+    enum Level { NONE, STAT, HEADER, HASH };   // cost: none, stat, open+read header, read all
+    static unsigned bit(Level level) { return (level == NONE) ? 0 : 1u << level; }
+
+    unsigned loaded = 0;    // bit() of loaded levels
+    bool valid = false;     // true if stat succeeded
+    int err = 0;            // errno of failed stat or read
+    unsigned mode = 0;
+    uint64_t size = 0;
+    uint64_t inode = 0;
+    uint64_t dev = 0;
+    unsigned nlink = 0;
+    time_t mtime = 0;
+    long mtimeNs = 0;       // nano-second part of mtime, 0 if not available
+    bool hasExif = false;   // HEADER
+    time_t exifTime = 0;
+    uint64_t hash = 0;      // HASH
+
+    void set(const struct stat& info);
+    // Stat path, relative paths resolve against directory at init(), safe while main thread chdirs.
+    bool load(const char* path);
+    // Load missing levels in bit() mask, STAT is always loaded first, false if any failed.
+    bool need(const char* path, unsigned levels);
+
+    // Remember current directory as base for relative paths.
+    static void init();
+    // Open for read relative to init() directory.
+    static FILE* openRead(const char* path);
+    static int openFd(const char* path);
+};
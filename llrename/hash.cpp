@@ -0,0 +1,235 @@
+//-------------------------------------------------------------------------------------------------
+// File: hash.cpp
+// Author: Dennis Lang
+//
+// Desc: Fast non-cryptographic content hash (xxHash64)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "hash.hpp"
+#include "stats.hpp"
+#include "filemeta.hpp"
+
+#include <stdio.h>
+#include <errno.h>
+#include <memory>
+#include <algorithm>
+#include <sys/stat.h>
+
+#ifdef HAVE_WIN
+#include <io.h>
+#define read _read
+#define close _close
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+static const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+static const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t rotl(uint64_t val, unsigned bits) {
+    return (val << bits) | (val >> (64 - bits));
+}
+
+// Little endian load, compilers turn the memcpy into one move.
+static inline uint64_t read64(const unsigned char* ptr) {
+    uint64_t val;
+    memcpy(&val, ptr, sizeof(val));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+    return val;
+}
+
+static inline uint32_t read32(const unsigned char* ptr) {
+    uint32_t val;
+    memcpy(&val, ptr, sizeof(val));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    val = __builtin_bswap32(val);
+#endif
+    return val;
+}
+
+static inline uint64_t round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME2;
+    return rotl(acc, 31) * PRIME1;
+}
+
+static inline uint64_t mergeRound(uint64_t hash, uint64_t acc) {
+    hash ^= round(0, acc);
+    return hash * PRIME1 + PRIME4;
+}
+
+//-------------------------------------------------------------------------------------------------
+Hash::Hash(uint64_t _seed) : seed(_seed), totalLen(0), tailLen(0) {
+    acc[0] = seed + PRIME1 + PRIME2;
+    acc[1] = seed + PRIME2;
+    acc[2] = seed;
+    acc[3] = seed - PRIME1;
+}
+
+//-------------------------------------------------------------------------------------------------
+void Hash::update(const void* data, size_t len) {
+    const unsigned char* ptr = (const unsigned char*)data;
+    const unsigned char* end = ptr + len;
+    totalLen += len;
+
+    if (tailLen + len < 32) {
+        memcpy(tail + tailLen, ptr, len);
+        tailLen += len;
+        return;
+    }
+    if (tailLen != 0) {
+        size_t fill = 32 - tailLen;
+        memcpy(tail + tailLen, ptr, fill);
+        for (unsigned lane = 0; lane < 4; lane++)
+            acc[lane] = round(acc[lane], read64(tail + lane * 8));
+        ptr += fill;
+        tailLen = 0;
+    }
+
+    // Four independent lanes, the main loop the compiler can keep in registers.
+    uint64_t v1 = acc[0], v2 = acc[1], v3 = acc[2], v4 = acc[3];
+    for (; ptr + 32 <= end; ptr += 32) {
+        v1 = round(v1, read64(ptr));
+        v2 = round(v2, read64(ptr + 8));
+        v3 = round(v3, read64(ptr + 16));
+        v4 = round(v4, read64(ptr + 24));
+    }
+    acc[0] = v1; acc[1] = v2; acc[2] = v3; acc[3] = v4;
+
+    tailLen = end - ptr;
+    memcpy(tail, ptr, tailLen);
+}
+
+//-------------------------------------------------------------------------------------------------
+uint64_t Hash::digest() const {
+    uint64_t hash;
+    if (totalLen >= 32) {
+        hash = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12) + rotl(acc[3], 18);
+        for (unsigned lane = 0; lane < 4; lane++)
+            hash = mergeRound(hash, acc[lane]);
+    } else {
+        hash = seed + PRIME5;
+    }
+    hash += totalLen;
+
+    const unsigned char* ptr = tail;
+    const unsigned char* end = tail + tailLen;
+    for (; ptr + 8 <= end; ptr += 8) {
+        hash ^= round(0, read64(ptr));
+        hash = rotl(hash, 27) * PRIME1 + PRIME4;
+    }
+    if (ptr + 4 <= end) {
+        hash ^= (uint64_t)read32(ptr) * PRIME1;
+        hash = rotl(hash, 23) * PRIME2 + PRIME3;
+        ptr += 4;
+    }
+    for (; ptr < end; ptr++) {
+        hash ^= (*ptr) * PRIME5;
+        hash = rotl(hash, 11) * PRIME1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+uint64_t Hash::of(const void* data, size_t len, uint64_t seed) {
+    Hash hash(seed);
+    hash.update(data, len);
+    return hash.digest();
+}
+
+//-------------------------------------------------------------------------------------------------
+// Per thread aligned read buffer, reused for every file the worker hashes.
+static unsigned char* readBuffer() {
+    thread_local std::unique_ptr<unsigned char[]> buffer;
+    if (!buffer) {
+        buffer.reset(new unsigned char[Hash::BLOCK_SIZE + Hash::BLOCK_ALIGN]);
+    }
+    uintptr_t addr = (uintptr_t)buffer.get();
+    return (unsigned char*)((addr + Hash::BLOCK_ALIGN - 1) & ~(uintptr_t)(Hash::BLOCK_ALIGN - 1));
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Large files are memory mapped with sequential read ahead, small files and
+// files which can not be mapped are read in aligned blocks.
+bool Hash::ofFile(const char* path, uint64_t& outHash, uint64_t maxLen) {
+    int fd = FileMeta::openFd(path);
+    if (fd < 0)
+        return false;
+
+    Hash hash;
+    bool okay = true;
+    bool mapped = false;
+#ifndef HAVE_WIN
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && std::min((uint64_t)info.st_size, maxLen) >= MMAP_MIN) {
+        size_t size = (size_t)std::min((uint64_t)info.st_size, maxLen);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, size, MADV_SEQUENTIAL);
+            hash.update(data, size);
+            munmap(data, size);
+            Stats::add(Stats::BYTES_READ, size);
+            mapped = true;
+        }
+    }
+#endif
+
+    if (!mapped) {
+        unsigned char* buf = readBuffer();
+        while (maxLen != 0) {
+            auto len = read(fd, buf, (unsigned)std::min((uint64_t)BLOCK_SIZE, maxLen));
+            if (len <= 0) {
+                okay = (len == 0);
+                break;
+            }
+            hash.update(buf, (size_t)len);
+            Stats::add(Stats::BYTES_READ, (uint64_t)len);
+            maxLen -= (uint64_t)len;
+        }
+    }
+
+    int err = errno;
+    close(fd);
+    outHash = hash.digest();
+    errno = err;
+    return okay;
+}
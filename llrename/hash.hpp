@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------------------------------
+// File: hash.hpp
+// Author: Dennis Lang
+//
+// Desc: Fast non-cryptographic content hash (xxHash64)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <stdint.h>
+#include <stddef.h>
+
+//-------------------------------------------------------------------------------------------------
+// xxHash64, used to name files by content. Not cryptographic, 64 bits is enough
+// to tell files apart, dedup still compares sizes before trusting a hash.
+class Hash {
+public:
+    static const size_t BLOCK_SIZE = 1 << 20;       // read size when not mapped
+    static const size_t BLOCK_ALIGN = 4096;
+    static const uint64_t MMAP_MIN = 256 * 1024;    // smaller files are cheaper to read
+    Hash(uint64_t seed = 0);
+
+    void update(const void* data, size_t len);
+    uint64_t digest() const;
+
+    static uint64_t of(const void* data, size_t len, uint64_t seed = 0);
+
+    // Hash first maxLen bytes of file, false and errno set on failure. Called from workers.
+    static bool ofFile(const char* path, uint64_t& outHash, uint64_t maxLen = UINT64_MAX);
+
+private:
+    uint64_t acc[4];
+    uint64_t seed;
+    uint64_t totalLen;
+    unsigned char tail[32];
+    size_t tailLen;
+};
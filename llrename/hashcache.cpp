@@ -0,0 +1,129 @@
+//-------------------------------------------------------------------------------------------------
+// File: hashcache.cpp
+// Author: Dennis Lang
+//
+// Desc: Persistent content hash cache (-hashCache)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "hashcache.hpp"
+#include "stats.hpp"
+
+#include <stdio.h>
+#include <errno.h>
+#include <mutex>
+#include <unordered_map>
+
+struct CacheKey {
+    uint64_t dev;
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtimeNs;
+
+    bool operator==(const CacheKey& other) const {
+        return dev == other.dev && inode == other.inode && size == other.size && mtimeNs == other.mtimeNs;
+    }
+};
+
+struct CacheKeyHash {
+    size_t operator()(const CacheKey& key) const {
+        uint64_t val = key.inode * 0x9E3779B185EBCA87ULL ^ key.dev ^ (key.size << 17) ^ (uint64_t)key.mtimeNs;
+        return (size_t)(val ^ (val >> 29));
+    }
+};
+
+bool HashCache::enabled = false;
+
+static std::mutex cacheMutex;
+static std::unordered_map<CacheKey, uint64_t, CacheKeyHash> cache;
+static lstring cachePath;
+static bool changed = false;
+
+static CacheKey makeKey(const FileMeta& meta) {
+    return CacheKey { meta.dev, meta.inode, meta.size, (int64_t)meta.mtime * 1000000000 + meta.mtimeNs };
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool HashCache::open(const char* path) {
+    cachePath = path;
+    enabled = true;
+    FILE* file = fopen(path, "r");
+    if (file == nullptr)
+        return errno == ENOENT;
+
+    unsigned long long dev, inode, size, hash;
+    long long mtimeNs;
+    while (fscanf(file, "%llu %llu %llu %lld %llx", &dev, &inode, &size, &mtimeNs, &hash) == 5) {
+        cache[CacheKey { dev, inode, size, mtimeNs }] = hash;
+    }
+    fclose(file);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool HashCache::find(const FileMeta& meta, uint64_t& outHash) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto iter = cache.find(makeKey(meta));
+    if (iter == cache.end())
+        return false;
+    Stats::add(Stats::HASH_CACHED);
+    outHash = iter->second;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void HashCache::add(const FileMeta& meta, uint64_t hash) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache[makeKey(meta)] = hash;
+    changed = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Write to temporary file and rename over cache, so an interrupted write keeps the old cache.
+bool HashCache::close() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (!enabled || !changed)
+        return true;
+    changed = false;
+
+    lstring tmpPath = cachePath + ".tmp";
+    FILE* file = fopen(tmpPath, "w");
+    if (file == nullptr)
+        return false;
+    for (const auto& item : cache) {
+        const CacheKey& key = item.first;
+        fprintf(file, "%llu %llu %llu %lld %016llx\n", (unsigned long long)key.dev, (unsigned long long)key.inode,
+            (unsigned long long)key.size, (long long)key.mtimeNs, (unsigned long long)item.second);
+    }
+    bool okay = (fclose(file) == 0);
+    return okay && rename(tmpPath, cachePath) == 0;
+}
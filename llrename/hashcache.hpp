@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------
+// File: hashcache.hpp
+// Author: Dennis Lang
+//
+// Desc: Persistent content hash cache (-hashCache)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+#include "filemeta.hpp"
+
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// Content hashes keyed by (dev, inode, size, mtime). A file whose key is unchanged since
+// the last run is not read again. The cache is a text file loaded at start and rewritten
+// at exit only if new hashes were added. Lookups are safe from prefetch workers.
+class HashCache {
+public:
+    static bool enabled;
+
+    // Load cache, missing file is an empty cache.
+    static bool open(const char* path);
+    static bool find(const FileMeta& meta, uint64_t& outHash);
+    static void add(const FileMeta& meta, uint64_t hash);
+    // Write cache if changed.
+    static bool close();
+};
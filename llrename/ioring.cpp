@@ -0,0 +1,311 @@
+//-------------------------------------------------------------------------------------------------
+// File: ioring.cpp
+// Author: Dennis Lang
+//
+// Desc: Batched rename and statx using Linux io_uring (-uring)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "ioring.hpp"
+#include "directory.hpp"
+#include "stats.hpp"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <algorithm>
+
+#ifdef HAVE_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_IO_URING
+#include <sys/mman.h>
+#include <sys/sysmacros.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE (1 << 0)
+#endif
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// [static] Synchronous fallback for one operation.
+void IoRing::runSync(Op& op) {
+    int code = 0;
+    switch (op.kind) {
+    case Op::RENAME:
+        Stats::add(Stats::SYS_RENAME);
+#if defined(__linux__) && defined(RENAME_NOREPLACE)
+        code = renameat2(AT_FDCWD, op.path, AT_FDCWD, op.path2, (op.flags & NOREPLACE) ? RENAME_NOREPLACE : 0);
+        if (code == 0 || errno != EINVAL || (op.flags & NOREPLACE) == 0)
+            break;
+        // Filesystem without RENAME_NOREPLACE, check then rename.
+#elif defined(__APPLE__)
+        code = (op.flags & NOREPLACE) ? renamex_np(op.path, op.path2, RENAME_EXCL) : ::rename(op.path, op.path2);
+        break;
+#endif
+        if ((op.flags & NOREPLACE) != 0 && DirUtil::fileExists(op.path2)) {
+            errno = EEXIST;
+            code = -1;
+        } else {
+            code = ::rename(op.path, op.path2);
+        }
+        break;
+    case Op::STAT:
+        Stats::add(Stats::SYS_STAT);
+        code = stat(op.path, op.info);
+        break;
+    }
+    op.result = (code == 0) ? 0 : -errno;
+}
+
+#ifdef HAVE_IO_URING
+
+//-------------------------------------------------------------------------------------------------
+IoRing::IoRing(unsigned depth) : ringFd(-1), ringDepth(depth),
+    sqRing(MAP_FAILED), cqRing(MAP_FAILED), sqes(MAP_FAILED) {
+    supported[Op::RENAME] = supported[Op::STAT] = false;
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd = (int)syscall(__NR_io_uring_setup, depth, &params);
+    if (ringFd < 0)
+        return;
+
+    ringDepth = params.sq_entries;
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+    sqRing = mmap(0, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? sqRing
+        : mmap(0, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes = mmap(0, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqes == MAP_FAILED) {
+        shutdown();
+        return;
+    }
+
+    char* sqPtr = (char*)sqRing;
+    sqHead = (unsigned*)(sqPtr + params.sq_off.head);
+    sqTail = (unsigned*)(sqPtr + params.sq_off.tail);
+    sqMask = (unsigned*)(sqPtr + params.sq_off.ring_mask);
+    sqArray = (unsigned*)(sqPtr + params.sq_off.array);
+    char* cqPtr = (char*)cqRing;
+    cqHead = (unsigned*)(cqPtr + params.cq_off.head);
+    cqTail = (unsigned*)(cqPtr + params.cq_off.tail);
+    cqMask = (unsigned*)(cqPtr + params.cq_off.ring_mask);
+    cqes = cqPtr + params.cq_off.cqes;
+    statxBuf.resize(ringDepth);
+
+    // Ring setup works on kernels without RENAMEAT (5.11) or STATX (5.6), where those
+    // operations fail with EINVAL. Ask which opcodes exist, the others run synchronously.
+    const unsigned probeOps = 256;
+    std::vector<char> probeBuf(sizeof(struct io_uring_probe) + probeOps * sizeof(struct io_uring_probe_op), 0);
+    struct io_uring_probe* probe = (struct io_uring_probe*)probeBuf.data();
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, probeOps) < 0) {
+        shutdown();     // before 5.6, none of our opcodes
+        return;
+    }
+    auto hasOp = [probe](unsigned opcode) {
+        return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+    };
+    supported[Op::RENAME] = hasOp(IORING_OP_RENAMEAT);
+    supported[Op::STAT] = hasOp(IORING_OP_STATX);
+}
+
+//-------------------------------------------------------------------------------------------------
+IoRing::~IoRing() {
+    shutdown();
+}
+
+//-------------------------------------------------------------------------------------------------
+// Unmap and close ring, later operations run synchronously.
+void IoRing::shutdown() {
+    if (sqes != MAP_FAILED)
+        munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    sqes = cqRing = sqRing = MAP_FAILED;
+    if (ringFd >= 0)
+        close(ringFd);
+    ringFd = -1;
+}
+
+//-------------------------------------------------------------------------------------------------
+static void statxToStat(const struct statx& stx, struct stat& info) {
+    memset(&info, 0, sizeof(info));
+    info.st_mode = stx.stx_mode;
+    info.st_nlink = stx.stx_nlink;
+    info.st_uid = stx.stx_uid;
+    info.st_gid = stx.stx_gid;
+    info.st_ino = stx.stx_ino;
+    info.st_size = (off_t)stx.stx_size;
+    info.st_blocks = (blkcnt_t)stx.stx_blocks;
+    info.st_dev = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+    info.st_mtim.tv_sec = stx.stx_mtime.tv_sec;
+    info.st_mtim.tv_nsec = stx.stx_mtime.tv_nsec;
+    info.st_ctim.tv_sec = stx.stx_ctime.tv_sec;
+    info.st_ctim.tv_nsec = stx.stx_ctime.tv_nsec;
+    info.st_atim.tv_sec = stx.stx_atime.tv_sec;
+    info.st_atim.tv_nsec = stx.stx_atime.tv_nsec;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Submit up to ringDepth operations and wait for all of them.
+void IoRing::runRing(Op** ops, size_t cnt) {
+    struct io_uring_sqe* sqeArray = (struct io_uring_sqe*)sqes;
+    unsigned startTail = __atomic_load_n(sqTail, __ATOMIC_RELAXED);
+    unsigned tail = startTail;
+    for (size_t idx = 0; idx < cnt; idx++) {
+        Op& op = *ops[idx];
+        unsigned slot = tail & *sqMask;
+        struct io_uring_sqe& sqe = sqeArray[slot];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.user_data = idx;
+        switch (op.kind) {
+        case Op::RENAME:
+            Stats::add(Stats::SYS_RENAME);
+            sqe.opcode = IORING_OP_RENAMEAT;
+            sqe.fd = AT_FDCWD;
+            sqe.addr = (uint64_t)op.path;
+            sqe.len = (uint32_t)AT_FDCWD;
+            sqe.addr2 = (uint64_t)op.path2;
+            sqe.rename_flags = (op.flags & NOREPLACE) ? RENAME_NOREPLACE : 0;
+            break;
+        case Op::STAT:
+            Stats::add(Stats::SYS_STAT);
+            sqe.opcode = IORING_OP_STATX;
+            sqe.fd = AT_FDCWD;
+            sqe.addr = (uint64_t)op.path;
+            sqe.len = STATX_BASIC_STATS;
+            sqe.off = (uint64_t)&statxBuf[idx];
+            break;
+        }
+        sqArray[slot] = slot;
+        tail++;
+    }
+    __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+    size_t done = 0;
+    unsigned toSubmit = (unsigned)cnt;
+    bool failed = false;
+    while (done < cnt) {
+        int got = (int)syscall(__NR_io_uring_enter, ringFd, failed ? 0 : toSubmit, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (got < 0 && errno != EINTR && errno != EAGAIN) {
+            if (failed)
+                break;
+            // Ring failed, wait only for the entries the kernel already took.
+            failed = true;
+            unsigned submitted = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) - startTail;
+            for (size_t idx = submitted; idx < cnt; idx++) {
+                runSync(*ops[idx]);
+                done++;
+            }
+            continue;
+        }
+        if (got > 0 && !failed)
+            toSubmit -= std::min((unsigned)got, toSubmit);
+
+        unsigned head = __atomic_load_n(cqHead, __ATOMIC_RELAXED);
+        unsigned cqTailNow = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != cqTailNow) {
+            struct io_uring_cqe& cqe = ((struct io_uring_cqe*)cqes)[head & *cqMask];
+            Op& op = *ops[cqe.user_data];
+            op.result = cqe.res;
+            if (op.kind == Op::STAT && cqe.res == 0)
+                statxToStat(statxBuf[cqe.user_data], *op.info);
+            head++;
+            done++;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    if (failed) {
+        // Stop using the ring, no stale entries or completions reach a later batch.
+        // An entry still in flight may or may not have run, report it as failed.
+        shutdown();
+        for (size_t idx = 0; idx < cnt; idx++)
+            if (ops[idx]->result == INT32_MIN)
+                ops[idx]->result = -EIO;
+    }
+
+    // Filesystems without RENAME_NOREPLACE support return EINVAL, retry synchronously.
+    for (size_t idx = 0; idx < cnt; idx++) {
+        if (ops[idx]->kind == Op::RENAME && ops[idx]->result == -EINVAL && (ops[idx]->flags & NOREPLACE) != 0)
+            runSync(*ops[idx]);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void IoRing::run(std::vector<Op>& ops) {
+    std::vector<Op*> ringOps;
+    ringOps.reserve(ops.size());
+    for (Op& op : ops) {
+        op.result = INT32_MIN;     // pending
+        if (ringFd >= 0 && supported[op.kind])
+            ringOps.push_back(&op);
+        else
+            runSync(op);
+    }
+    for (size_t off = 0; off < ringOps.size(); off += ringDepth) {
+        if (ringFd < 0) {
+            // Ring shut down by a failed batch.
+            for (size_t idx = off; idx < ringOps.size(); idx++)
+                runSync(*ringOps[idx]);
+            break;
+        }
+        runRing(ringOps.data() + off, std::min((size_t)ringDepth, ringOps.size() - off));
+    }
+}
+
+#else
+
+//-------------------------------------------------------------------------------------------------
+IoRing::IoRing(unsigned depth) : ringFd(-1), ringDepth(depth) {
+}
+
+//-------------------------------------------------------------------------------------------------
+IoRing::~IoRing() {
+}
+
+//-------------------------------------------------------------------------------------------------
+void IoRing::run(std::vector<Op>& ops) {
+    for (Op& op : ops)
+        runSync(op);
+}
+
+#endif
@@ -0,0 +1,104 @@
+//-------------------------------------------------------------------------------------------------
+// File: ioring.hpp
+// Author: Dennis Lang
+//
+// Desc: Batched rename and statx using Linux io_uring (-uring)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <vector>
+#include <sys/stat.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING
+#endif
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Queue of independent file operations. On Linux the operations are submitted to an io_uring
+// in large batches and run by the kernel while llrename waits on one completion loop.
+// When io_uring is unavailable (old kernel, seccomp, macOS, Windows) run() performs the
+// same operations with synchronous system calls, so callers need one code path.
+class IoRing {
+public:
+    static const unsigned NOREPLACE = 1;    // rename fails with EEXIST if target exists
+
+    struct Op {
+        enum Kind { RENAME, STAT };
+        Kind kind;
+        const char* path;       // must stay valid until run() returns
+        const char* path2;      // rename target
+        unsigned flags;         // NOREPLACE for RENAME
+        struct stat* info;      // STAT result
+        int result;             // 0 on success, -errno on failure
+    };
+
+    IoRing(unsigned depth = 256);
+    ~IoRing();
+
+    // True if kernel ring is active, false means synchronous fallback.
+    bool isAsync() const { return ringFd >= 0; }
+    unsigned depth() const { return ringDepth; }
+
+    // Run all operations, order of execution within a batch is not defined.
+    void run(std::vector<Op>& ops);
+
+    static void runSync(Op& op);
+
+private:
+    IoRing(const IoRing&);
+    void runRing(Op** ops, size_t cnt);
+    void shutdown();
+
+    int ringFd;
+    unsigned ringDepth;
+#ifdef HAVE_IO_URING
+    bool supported[2];      // per Op::Kind, from IORING_REGISTER_PROBE
+    void* sqRing;
+    void* cqRing;
+    void* sqes;
+    size_t sqRingSize;
+    size_t cqRingSize;
+    size_t sqesSize;
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    void* cqes;
+    std::vector<struct statx> statxBuf;
+#endif
+};
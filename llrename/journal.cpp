@@ -0,0 +1,113 @@
+//-------------------------------------------------------------------------------------------------
+// File: journal.cpp
+// Author: Dennis Lang
+//
+// Desc: Record of applied renames (-journal)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "journal.hpp"
+
+#include <stdio.h>
+#include <time.h>
+#include <mutex>
+
+static std::mutex journalMutex;
+static FILE* journalFile = nullptr;
+static lstring journalPath;
+static uint64_t appliedCnt = 0;
+static time_t lastFlush = 0;
+static lstring lastOld, lastNew;
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool Journal::open(const char* path) {
+    close();
+    journalPath = path;
+    journalFile = fopen(path, "w");
+    if (journalFile != nullptr)
+        setvbuf(journalFile, nullptr, _IOFBF, 1 << 16);
+    return journalFile != nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Journal::close() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    if (journalFile != nullptr) {
+        fclose(journalFile);
+        journalFile = nullptr;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Journal::flush() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    if (journalFile != nullptr)
+        fflush(journalFile);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Record completed rename.
+void Journal::add(const char* oldName, const char* newName) {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    appliedCnt++;
+    lastOld = oldName;
+    lastNew = newName;
+    if (journalFile != nullptr) {
+        fprintf(journalFile, "\"%s\",\"%s\"\n", oldName, newName);
+        time_t now = time(nullptr);
+        if (now != lastFlush) {
+            lastFlush = now;
+            fflush(journalFile);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+uint64_t Journal::count() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    return appliedCnt;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+const lstring& Journal::path() {
+    return journalPath;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Journal::lastApplied(lstring& oldName, lstring& newName) {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    oldName = lastOld;
+    newName = lastNew;
+}
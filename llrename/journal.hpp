@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------
+// File: journal.hpp
+// Author: Dennis Lang
+//
+// Desc: Record of applied renames (-journal)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// Each applied rename is appended as "old","new" so the journal can be replayed
+// with -fromList, or undone with -fromList -2. The journal is flushed at least
+// once a second and on cancel, so it is accurate up to the last completed rename.
+class Journal {
+public:
+    static bool open(const char* path);
+    static void close();
+    static void flush();
+
+    static void add(const char* oldName, const char* newName);
+
+    static uint64_t count();
+    static const lstring& path();
+    static void lastApplied(lstring& oldName, lstring& newName);
+};
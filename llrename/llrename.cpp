@@ -40,6 +40,23 @@
 #include "dirscan.hpp"
 #include "directory.hpp"
 #include "parseutil.hpp"
+#include "stats.hpp"
+#include "eventlog.hpp"
+#include "errors.hpp"
+#include "progress.hpp"
+#include "journal.hpp"
+#include "ioring.hpp"
+#include "filemeta.hpp"
+#include "prefetch.hpp"
+#include "hashcache.hpp"
+#include "dedup.hpp"
+#include "copyto.hpp"
+#include "filecopy.hpp"
+#include "threadpool.hpp"
+#include "dirnames.hpp"
+#include "plan.hpp"
+#include "postorder.hpp"
+#include "pathlist.hpp"
 
 #include <stdio.h>
 #include <ctype.h>
@@ -49,9 +66,12 @@
 #include <iomanip>
 #include <vector>
 #include <map>
-#include <unordered_set>  
+#include <deque>
+#include <unordered_set>
+#include <unordered_map>
 #include <algorithm>
 #include <regex>
+#include <mutex>
 #include <exception>
 #include <assert.h>
 
@@ -94,6 +114,7 @@ static char CWD_BUF[MAX_PATH];
 static unsigned CWD_LEN = 0;
 const unsigned START_NUM = 1;
 static unsigned num = START_NUM;
+static std::atomic<unsigned> renamedCnt { 0 };  // renames done, num numbers the new names
 static unsigned modifyNum = 0;  // 0=no modification
 
 static bool showFile = false;
@@ -103,10 +124,13 @@ static bool fullPath = false;
 static bool invert = false;
 static bool smartQuote = false; // only quote if spaces
 static bool force = false;      // delete target if same name
+static bool progress = false;   // show progress line
+static lstring progressEst;     // "count" or expected number of entries
 static bool wideTo8 = false;    // Convert wide character names to multi-byte (utf-8)
 
 static char casefold = '-';
 static lstring parts;
+static unsigned metaLevels = 0;    // FileMeta::bit() mask of metadata used by -parts and -dedup
 static bool doDirectories = false;
 
 static lstring logPrefix = "";
@@ -115,8 +139,12 @@ static lstring logEndl = "\n";
 
 static fstream inListStream;
 static lstring inListPath;
+static lstring filesFromPath;   // -files0-from, "-" is stdin
+static lstring copyToPath;      // -copyTo, opened after all options for -no
+static const uint64_t LIST_MEM_LIMIT = 256 << 20;  // plan of -fromList without -memLimit
 static fstream outListStream;
 static lstring outListPath;
+static std::mutex outListMutex;
 
 class Substitute { 
 public:
@@ -147,6 +175,7 @@ static void doChdir(const char* dir) {
         return;
     }
 
+    Stats::add(Stats::SYS_CHDIR);
     if (chdir(dir) == 0) {
         lastChdir = dir;
         if (verbose)
@@ -157,51 +186,453 @@ static void doChdir(const char* dir) {
 }
 
 // ---------------------------------------------------------------------------
-static int doRenameC(const char* oldName, const char* newName) {
-    if (stricmp(oldName, newName) == 0 || !DirUtil::fileExists(newName)) {
-        return (dryRun) ? 0 : rename(oldName, newName);
+// -force replaces a target, except when a plan moves a temporary name back to its source.
+static bool replaceTarget() {
+    return force && Plan::pass != Plan::HOP_BACK;
+}
+
+// ---------------------------------------------------------------------------
+// True if name exists in dir, from the scanned listing when cached.
+// path is the name valid for a system call, absolute or relative to doChdir().
+static bool targetExists(const lstring& dir, const char* path) {
+    lstring name;
+    DirNames::Found found = DirNames::exists(dir, DirUtil::getName(name, path));
+    if (found != DirNames::UNKNOWN)
+        return found == DirNames::YES;
+    return DirUtil::fileExists(path);
+}
+
+// ---------------------------------------------------------------------------
+// Case mode of dir if newName only changes letter case of oldName, else EXACT.
+static DirNames::CaseMode caseOnlyMode(const lstring& dir, const char* oldName, const char* newName) {
+    if (strcmp(oldName, newName) == 0 || stricmp(oldName, newName) != 0)
+        return DirNames::EXACT;
+    return DirNames::caseMode(dir);
+}
+
+// ---------------------------------------------------------------------------
+// Case only rename on a filesystem which ignores it, rename via a temp name.
+static int caseHop(const char* oldName, const char* newName) {
+    lstring tmpName = lstring(oldName) + ".llcase";
+    if (DirUtil::fileExists(tmpName)) {
+        errno = EEXIST;
+        return -1;
+    }
+    Stats::add(Stats::SYS_RENAME);
+    if (rename(oldName, tmpName) != 0)
+        return -1;
+    Stats::add(Stats::SYS_RENAME);
+    if (rename(tmpName, newName) == 0)
+        return 0;
+    int err = errno;
+    rename(tmpName, oldName);
+    errno = err;
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// Rename within dir. On a case folding filesystem a case only rename targets the
+// same file, so it skips the existence check, anywhere else the target must be free.
+static int doRenameC(const lstring& dir, const char* oldName, const char* newName) {
+    DirNames::CaseMode caseMode = caseOnlyMode(dir, oldName, newName);
+    if (strcmp(oldName, newName) == 0 || caseMode != DirNames::EXACT || !targetExists(dir, newName)) {
+        if (dryRun)
+            return 0;
+        uint64_t startNs = Stats::enabled ? Stats::wallNow() : 0;
+        int code;
+        if (caseMode == DirNames::FOLD_HOP) {
+            code = caseHop(oldName, newName);
+        } else {
+            // A cached listing may be stale, the rename itself refuses an existing target.
+            bool sameFile = strcmp(oldName, newName) == 0 || caseMode != DirNames::EXACT;
+            IoRing::Op op { IoRing::Op::RENAME, oldName, newName, (replaceTarget() || sameFile) ? 0 : IoRing::NOREPLACE, nullptr, 0 };
+            IoRing::runSync(op);
+            code = (op.result == 0) ? 0 : -1;
+            errno = -op.result;
+            if (op.result == -EEXIST) {
+                lstring name;
+                DirNames::added(dir, DirUtil::getName(name, newName));
+            }
+        }
+        if (Stats::enabled)
+            Stats::latency(Stats::wallNow() - startNs);
+        return code;
+    } else {
+        errno = EEXIST;     // reported by caller
+        return -1;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Record result of rename in stats, logs and journal, report errors.
+static void renameDone(const char* oldName, const char* newName, const lstring& dir, int code, int err, uint64_t elapsedNs) {
+    const char* action = " rename ";
+    // HOP_START and HOP_BACK move a file to and from its temporary name, no rename of its own.
+    bool hopOnly = Plan::pass == Plan::HOP_START || Plan::pass == Plan::HOP_BACK;
+    if (code == 0) {
+        if (!hopOnly)
+            renamedCnt++;
+        Stats::add(Stats::RENAMED);
+        Progress::inc(Progress::renamed);
+        if (!dryRun) {
+            // A planned hop is journaled once, as the rename it completes, so undo can replan.
+            if (Plan::pass == Plan::HOP_END)
+                Journal::add(lstring(oldName, strlen(oldName) - strlen(Plan::HOP_EXT)), newName);
+            else if (!hopOnly)
+                Journal::add(oldName, newName);
+            EventLog::write(EventLog::APPLY, oldName, newName, 0, elapsedNs);
+        }
     } else {
-         Colors::showError("New file already exists:", newName);
-         return 0;
+        Stats::failure(err);
+        EventLog::write(EventLog::FAIL, oldName, newName, err, elapsedNs);
+        if (Plan::pass == Plan::HOP_BACK && !dryRun) {
+            // Source left under its temporary name, journaled so undo restores it.
+            Colors::showError("Left under temporary name ", oldName);
+            Journal::add(newName, oldName);
+        }
+    }
+
+    if (verbose || code != 0) {
+        unsigned strOffset = (fullPath || strncasecmp(oldName, CWD_BUF, CWD_LEN) !=0) ? 0 :  CWD_LEN;
+        if (code != 0)
+            Errors::add(err, action, dir, oldName + strOffset, newName + strOffset);
+        else
+            Colors::showError("", action, oldName + strOffset, "\n     to ", newName + strOffset);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Path relative to start directory made absolute, so it is valid after doChdir().
+static lstring absPath(const char* path) {
+#ifdef HAVE_WIN
+    bool isAbs = path[0] == '\\' || (path[0] != '\0' && path[1] == ':');
+#else
+    bool isAbs = path[0] == '/';
+#endif
+    return isAbs ? lstring(path) : lstring(CWD_BUF) + Directory_files::SLASH + path;
+}
+
+// ---------------------------------------------------------------------------
+// Renames queued for -uring, run as one batch.
+struct PendingRename {
+    lstring oldName;
+    lstring newName;
+    lstring dir;
+    lstring oldPath;    // absolute, valid after doChdir()
+    lstring newPath;
+};
+static IoRing* ioRing = nullptr;
+static std::vector<PendingRename> pendingRenames;
+static std::unordered_set<std::string> pendingNames;
+
+// ---------------------------------------------------------------------------
+static void flushRenames() {
+    if (pendingRenames.empty())
+        return;
+
+    Stats::Timer timer(Stats::RENAME);
+    std::vector<IoRing::Op> ops(pendingRenames.size());
+    for (size_t idx = 0; idx < ops.size(); idx++) {
+        const PendingRename& item = pendingRenames[idx];
+        IoRing::Op& op = ops[idx];
+        op.kind = IoRing::Op::RENAME;
+        op.path = item.oldPath;
+        op.path2 = item.newPath;
+        // Case only rename must not be refused by a case folding filesystem.
+        op.flags = (replaceTarget() || caseOnlyMode(item.dir, item.oldName, item.newName) != DirNames::EXACT) ? 0 : IoRing::NOREPLACE;
+        op.info = nullptr;
+    }
+
+    uint64_t startNs = Stats::wallNow();
+    ioRing->run(ops);
+    uint64_t elapsedNs = (Stats::wallNow() - startNs) / ops.size();
+    lstring name1, name2;
+    for (size_t idx = 0; idx < ops.size(); idx++) {
+        const PendingRename& item = pendingRenames[idx];
+        int code = (ops[idx].result == 0) ? 0 : -1;
+        if (code == 0)
+            DirNames::renamed(item.dir, DirUtil::getName(name1, item.oldName), DirUtil::getName(name2, item.newName));
+        renameDone(item.oldName, item.newName, item.dir, code, -ops[idx].result, elapsedNs);
+    }
+    if (Stats::enabled)
+        Stats::latency(elapsedNs);
+
+    pendingRenames.clear();
+    pendingNames.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Queue rename for batch, flush first if batch is full, changes directory,
+// or touches a name already in the batch since batch order is not defined.
+static void queueRename(const char* oldName, const char* newName, const lstring& dir) {
+    if (!pendingRenames.empty()) {
+        if (pendingRenames.size() >= ioRing->depth()
+                || pendingRenames.back().dir != dir
+                || pendingNames.count(oldName) != 0
+                || pendingNames.count(newName) != 0) {
+            flushRenames();
+        }
+    }
+    EventLog::write(EventLog::PLAN, oldName, newName);
+    pendingNames.insert(oldName);
+    pendingNames.insert(newName);
+    pendingRenames.push_back(PendingRename { oldName, newName, dir, absPath(oldName), absPath(newName) });
+}
+
+// ---------------------------------------------------------------------------
+// Device of directory, cached since many files move into the same target directory.
+static uint64_t dirDevice(const lstring& dir) {
+    static std::unordered_map<std::string, uint64_t> devices;
+    auto iter = devices.find(dir);
+    if (iter != devices.end())
+        return iter->second;
+    struct stat info;
+    Stats::add(Stats::SYS_STAT);
+    uint64_t device = (stat(dir, &info) == 0) ? (uint64_t)info.st_dev : 0;
+    devices[dir] = device;
+    return device;
+}
+
+static ThreadPool* movePool = nullptr;
+
+// ---------------------------------------------------------------------------
+// Move to other directory, creating it if needed. Same filesystem is one rename,
+// across filesystems a worker copies, syncs and deletes the source.
+static int doMove(const char* oldName, const char* newName) {
+    lstring oldPath = absPath(oldName);
+    lstring newPath = absPath(newName);
+    lstring dir1, dir2;
+    DirUtil::getDir(dir1, oldPath);
+    DirUtil::getDir(dir2, newPath);
+    lstring name;
+    DirUtil::getName(name, newPath);
+    EventLog::write(EventLog::PLAN, oldName, newName);
+    uint64_t startNs = Stats::wallNow();
+
+    int code = 0;
+    if (!dryRun && !FileCopy::makeDirs(dir2)) {
+        code = -1;
+    } else if (targetExists(dir2, newPath)) {
+        if (force) {
+            DirUtil::deleteFile(dryRun, newPath);
+            DirNames::removed(dir2, name);
+        } else {
+            errno = EEXIST;
+            code = -1;
+        }
+    }
+    if (code != 0 || dryRun) {
+        int err = errno;
+        renameDone(oldName, newName, dir2, code, err, Stats::wallNow() - startNs);
+        return code;
+    }
+
+    if (dirDevice(dir1) == dirDevice(dir2)) {
+        Stats::add(Stats::SYS_RENAME);
+        code = rename(oldPath, newPath);
+        if (code == 0 || errno != EXDEV) {
+            int err = errno;
+            if (code == 0) {
+                DirNames::removed(dir1, DirUtil::getName(name, oldPath));
+                DirNames::added(dir2, DirUtil::getName(name, newPath));
+            }
+            renameDone(oldName, newName, dir2, code, err, Stats::wallNow() - startNs);
+            return code;
+        }
+    }
+
+    // Source stays listed until the worker is done, target is listed now.
+    DirNames::added(dir2, name);
+    if (movePool == nullptr)
+        movePool = new ThreadPool();
+    lstring oldCopy = oldName, newCopy = newName;
+    movePool->add([oldPath, newPath, oldCopy, newCopy, dir2, startNs]() {
+        if (Signals::aborted)
+            return;
+        int code = FileCopy::move(oldPath, newPath) ? 0 : -1;
+        int err = errno;
+        renameDone(oldCopy, newCopy, dir2, code, err, Stats::wallNow() - startNs);
+    });
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Wait for moves across filesystems.
+static void finishMoves() {
+    if (movePool != nullptr) {
+        movePool->wait();
+        delete movePool;
+        movePool = nullptr;
     }
 }
 
 // ---------------------------------------------------------------------------
 static bool doRenameB(const char* oldName, const char* newName) {
+    Stats::Timer timer(Stats::RENAME);
     int code = 0;
-    const char* errMsg = "";
-    const char* action = " ";
- 
-    lstring dir1, dir2;
+
+    lstring dir1, dir2, name1, name2;
     DirUtil::getDir(dir1, oldName);
     DirUtil::getDir(dir2, newName);
     size_t dirLen = 0;
     
     if (dir1 == dir2) {
-        if (force && DirUtil::fileExists(newName)) {
+        // Plan hops run now, a failed hop is known before the next pass.
+        bool planHop = Plan::pass == Plan::HOP_START || Plan::pass == Plan::HOP_END || Plan::pass == Plan::HOP_BACK;
+        if (ioRing != nullptr && !dryRun && !planHop && caseOnlyMode(dir1, oldName, newName) != DirNames::FOLD_HOP) {
+            queueRename(oldName, newName, dir1);
+            return true;    // number is used, counted by renameDone() after the batch
+        }
+        if (replaceTarget() && targetExists(dir1, newName)) {
             DirUtil::deleteFile(dryRun, newName);
+            DirNames::removed(dir1, DirUtil::getName(name2, newName));
         }
+        EventLog::write(EventLog::PLAN, oldName, newName);
+        uint64_t startNs = EventLog::enabled ? Stats::wallNow() : 0;
 #ifdef HAVE_WIN
         // TODO - test if windows can do absolute file rename.
-        code = doRenameC(oldName, newName);  // rename absolute path
+        code = doRenameC(dir1, oldName, newName);  // rename absolute path
 #else
         doChdir(dir1);
         dirLen = dir1.empty() ? 0 : dir1.length() +1; // +1 skip trailing slash
-        code = doRenameC(oldName + dirLen, newName + dirLen);  // rename relative path, see doChdir()
+        code = doRenameC(dir1, oldName + dirLen, newName + dirLen);  // rename relative path, see doChdir()
 #endif
-        errMsg = (code == 0) ? "" : strerror(errno);
-        action = " rename ";
+        int err = errno;
+        if (code == 0) {
+            // Dry run also tracks names, so it reports the same conflicts as a real run.
+            DirNames::renamed(dir1, DirUtil::getName(name1, oldName), DirUtil::getName(name2, newName));
+            DirNames::forget(oldName);   // in case a directory was renamed
+        }
+        renameDone(oldName, newName, dir1, code, err, EventLog::enabled ? Stats::wallNow() - startNs : 0);
     } else {
-        Colors::showError("Can't rename subDir,  Base:", dir1," From:", oldName, " To:", newName);
+        code = doMove(oldName, newName);
     }
-    
 
-    if (verbose || code != 0) {
-        unsigned strOffset = (fullPath || strncasecmp(oldName, CWD_BUF, CWD_LEN) !=0) ? 0 :  CWD_LEN;
-        Colors::showError(errMsg, action, oldName + strOffset, "\n     to ", newName + strOffset);
+    return (code == 0);
+}
+
+// ---------------------------------------------------------------------------
+// Listings changed by plan workers, dropped from the name cache at the next barrier.
+static std::mutex planDirsMutex;
+static std::unordered_set<std::string> planDirs;
+
+// ---------------------------------------------------------------------------
+// Plan target claimed by an earlier source.
+static void planFailed(const char* oldName, const char* newName, int err) {
+    lstring dir;
+    DirUtil::getDir(dir, newName);
+    renameDone(oldName, newName, dir, -1, err, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Plan targets which no planned rename frees, okay cleared if one exists. The batch is
+// checked with one io_uring submission of STAT operations. A case only rename names
+// its own source.
+static void planTargetExists(std::vector<Plan::Pair>& batch) {
+    static IoRing ring;
+    std::vector<lstring> paths;
+    std::vector<struct stat> infos(batch.size());
+    std::vector<IoRing::Op> ops;
+    std::vector<size_t> opPair;
+    paths.reserve(batch.size());    // ops point into paths
+    for (size_t idx = 0; idx < batch.size(); idx++) {
+        if (stricmp(batch[idx].oldName, batch[idx].newName) == 0)
+            continue;
+        paths.push_back(absPath(batch[idx].newName));
+        ops.push_back(IoRing::Op { IoRing::Op::STAT, paths.back(), nullptr, 0, &infos[idx], 0 });
+        opPair.push_back(idx);
     }
+    ring.run(ops);
+    for (size_t opIdx = 0; opIdx < ops.size(); opIdx++)
+        batch[opPair[opIdx]].okay = (ops[opIdx].result != 0);
+}
 
-    return (code == 0);
+// ---------------------------------------------------------------------------
+// Wait for queued and background renames between plan passes.
+static void planBarrier() {
+    if (ioRing != nullptr)
+        flushRenames();
+    finishMoves();
+    for (const std::string& dir : planDirs)
+        DirNames::forget(dir);
+    planDirs.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Planned renames of one source directory, run on a Plan worker. Paths are absolute since
+// workers must not chdir. The batch goes to the kernel as one io_uring submission with
+// RENAME_NOREPLACE, which checks every target while renaming.
+static std::mutex planCaseMutex;    // case mode cache is shared by workers
+static void planBatch(std::vector<Plan::Pair>& batch) {
+    static thread_local IoRing ring;
+    std::vector<lstring> oldPaths(batch.size()), newPaths(batch.size()), dirs(batch.size());
+    std::vector<IoRing::Op> ops;
+    std::vector<size_t> opPair;
+    std::vector<int> codes(batch.size(), 0), errs(batch.size(), 0);
+    lstring srcDir;
+    uint64_t startNs = Stats::wallNow();
+
+    for (size_t idx = 0; idx < batch.size(); idx++) {
+        oldPaths[idx] = absPath(batch[idx].oldName);
+        newPaths[idx] = absPath(batch[idx].newName);
+        DirUtil::getDir(srcDir, oldPaths[idx]);
+        DirUtil::getDir(dirs[idx], newPaths[idx]);
+        EventLog::write(EventLog::PLAN, batch[idx].oldName, batch[idx].newName);
+        if (dryRun)
+            continue;
+        if (srcDir != dirs[idx] && !FileCopy::makeDirs(dirs[idx])) {
+            codes[idx] = -1;
+            errs[idx] = errno;
+            continue;
+        }
+
+        DirNames::CaseMode caseMode;
+        {
+            std::lock_guard<std::mutex> lock(planCaseMutex);
+            caseMode = caseOnlyMode(dirs[idx], oldPaths[idx], newPaths[idx]);
+        }
+        if (caseMode == DirNames::FOLD_HOP) {
+            codes[idx] = caseHop(oldPaths[idx], newPaths[idx]);
+            errs[idx] = errno;
+            continue;
+        }
+        unsigned flags = (force || caseMode != DirNames::EXACT) ? 0 : IoRing::NOREPLACE;
+        ops.push_back(IoRing::Op { IoRing::Op::RENAME, oldPaths[idx], newPaths[idx], flags, nullptr, 0 });
+        opPair.push_back(idx);
+    }
+
+    ring.run(ops);
+    for (size_t opIdx = 0; opIdx < ops.size(); opIdx++) {
+        size_t idx = opPair[opIdx];
+        int result = ops[opIdx].result;
+        if (result == -EXDEV) {
+            // Other filesystem, copy then delete source.
+            if (!force && DirUtil::fileExists(newPaths[idx]))
+                result = -EEXIST;
+            else
+                result = FileCopy::move(oldPaths[idx], newPaths[idx]) ? 0 : -errno;
+        }
+        codes[idx] = (result == 0) ? 0 : -1;
+        errs[idx] = -result;
+    }
+
+    // Name cache belongs to the main thread, see planBarrier().
+    {
+        std::lock_guard<std::mutex> lock(planDirsMutex);
+        lstring dir;
+        for (size_t idx = 0; idx < batch.size(); idx++) {
+            if (codes[idx] == 0) {
+                planDirs.insert(DirUtil::getDir(dir, batch[idx].oldName));
+                planDirs.insert(DirUtil::getDir(dir, batch[idx].newName));
+            }
+        }
+    }
+
+    uint64_t elapsedNs = (Stats::wallNow() - startNs) / batch.size();
+    for (size_t idx = 0; idx < batch.size(); idx++) {
+        batch[idx].okay = (codes[idx] == 0);
+        renameDone(batch[idx].oldName, batch[idx].newName, dirs[idx], codes[idx], errs[idx], elapsedNs);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -216,10 +647,17 @@ static void removeQuote(lstring& word) {
     }
 }
 
+// ---------------------------------------------------------------------------
+static bool readLine(istream& inStream, string& line) {
+    Stats::Timer timer(Stats::LIST_IO);
+    return (bool)std::getline(inStream, line);
+}
+
 // ---------------------------------------------------------------------------
 static void renameFromStream(istream& inStream) {
     string line;
-    while (std::getline(inStream, line)) {
+    while (!Signals::aborted && readLine(inStream, line)) {
+        Progress::inc(Progress::scanned);
         size_t divider = line.find("\",\"");
         if (divider == string::npos) {
             divider = line.find(',');
@@ -232,9 +670,17 @@ static void renameFromStream(istream& inStream) {
         removeQuote(file1);
         removeQuote(file2);
 
-        // Skip identical names.
-        if ((file1 != file2) && doRenameA(file1, file2))
+        // Skip identical names, a plan applies -2 inversion as pairs are added.
+        if (file1 == file2) {
+            continue;
+        } else if (Plan::enabled) {
+            if (invert)
+                Plan::add(file2, file1);
+            else
+                Plan::add(file1, file2);
+        } else if (doRenameA(file1, file2)) {
             num++;
+        }
     }
 }
 
@@ -273,7 +719,7 @@ static void shiftAlphaNumeric(string& outPath, unsigned shiftBy) {
 
 // ---------------------------------------------------------------------------
 // Handle "part" renaming. 
-static const lstring& getPartRename(lstring& outPath, const lstring& dir, lstring& name, unsigned num, unsigned modifyNum) {
+static const lstring& getPartRename(lstring& outPath, const lstring& dir, lstring& name, unsigned num, unsigned modifyNum, const FileMeta& meta) {
     string tmpName = name;  // make local copy so use string and not lstring
     if (modifyNum != 0) {
         shiftAlphaNumeric(tmpName, modifyNum);
@@ -287,35 +733,89 @@ static const lstring& getPartRename(lstring& outPath, const lstring& dir, lstrin
         DirUtil::getExt(extn, name);
         tmpName.resize(name.length() - extn.length() - 1);
         lstring part;
-        outPath += ParseUtil::getParts(part, parts, tmpName.c_str(), extn, num);
+        outPath += ParseUtil::getParts(part, parts, tmpName.c_str(), extn, num, &meta);
     }
    
     return outPath;
 }
 
-static std::unordered_set<size_t> NEW_FILES;
-static std::hash<std::string> HASH_STR;
+// ---------------------------------------------------------------------------
+// Names created by renames, per target directory, so a file renamed earlier is not renamed
+// again when seen later in the scan (circular rename AAAA -> 1111 and 1111 -> AAAA).
+// A directory scope is released once every entry scanned before the scan left the
+// directory has been handled, prefetch hands entries over in scan order.
+typedef std::unordered_set<std::string> NameSet;
+static std::unordered_map<std::string, NameSet> newNames;
+static std::deque<std::pair<size_t, lstring>> leftDirs;    // scannedCnt at exit, directory
+static size_t scannedCnt = 0;   // entries given to doRename or prefetch by the scan
+static size_t handledCnt = 0;   // entries doRename has started
+static std::string scopeDir;    // last scope looked up
+static NameSet* scope = nullptr;
 
 // ---------------------------------------------------------------------------
-// Open, read and parse file.
-static bool doRename(const lstring& filepath, const lstring& filename) {
-    lstring dirWithSlash, newFile;
-    
+static NameSet* findScope(std::string_view dir, bool create) {
+    if (scope != nullptr && dir == scopeDir)
+        return scope;
+    scopeDir.assign(dir.data(), dir.length());
+    auto iter = newNames.find(scopeDir);
+    if (iter == newNames.end()) {
+        if (!create)
+            return scope = nullptr;
+        iter = newNames.emplace(scopeDir, NameSet()).first;
+    }
+    return scope = &iter->second;
+}
+
+// ---------------------------------------------------------------------------
+static void releaseScopes(size_t doneCnt) {
+    while (!leftDirs.empty() && leftDirs.front().first <= doneCnt) {
+        auto iter = newNames.find(leftDirs.front().second);
+        if (iter != newNames.end()) {
+            if (scope == &iter->second)
+                scope = nullptr;
+            newNames.erase(iter);
+        }
+        leftDirs.pop_front();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Show scanned entry, with prefetched size and modify time if available.
+static void showFileMeta(const lstring& filepath, const FileMeta& meta) {
+    if (meta.valid) {
+        char timeBuf[40];
+        struct tm tmTime = *localtime(&meta.mtime);
+        strftime(timeBuf, sizeof(timeBuf), "%Y-%m-%d %H:%M:%S", &tmTime);
+        std::cout << std::setw(12) << meta.size << " " << timeBuf << " ";
+    }
+    std::cout << filepath << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// New path from case fold, substitutions and parts, dirWithSlash is the directory of filepath.
+static const lstring& getNewName(lstring& newFile, lstring& dirWithSlash, const lstring& filepath,
+        const lstring& filename, unsigned fileNum, const FileMeta& meta) {
     lstring tmpFile = filename;
     if (casefold == 'c')
-        tmpFile = tmpFile.toLower();
+        tmpFile.toLower();
     else if (casefold == 'C')
-        tmpFile = tmpFile.toUpper();
+        tmpFile.toUpper();
     
-    for(auto item : substituteList) {
+    for (const auto& item : substituteList) {
         tmpFile = regex_replace(tmpFile, item.subregFrom, item.subregTo);
     }
     
     DirUtil::getDir(dirWithSlash, filepath);
     if (!dirWithSlash.empty()) dirWithSlash += Directory_files::SLASH_CHAR;
-    getPartRename(newFile, dirWithSlash, tmpFile, num, modifyNum);
+    return getPartRename(newFile, dirWithSlash, tmpFile, fileNum, modifyNum, meta);
+}
 
+// ---------------------------------------------------------------------------
+// Output 'old','new' pair to -toList.
+static void writeList(const lstring& dirWithSlash, const lstring& filename, const lstring& newFile) {
     if (outListPath.size() > 0 && outListStream.good()) {
+        Stats::Timer listTimer(Stats::LIST_IO);
+        std::lock_guard<std::mutex> lock(outListMutex);
         unsigned strOffset = (fullPath || strncasecmp(dirWithSlash, CWD_BUF, CWD_LEN) !=0) ? 0 : CWD_LEN;
         lstring qOldFile = quote((dirWithSlash + filename) + strOffset, 0);
         lstring qNewFile = quote(newFile + strOffset, 0);
@@ -324,24 +824,65 @@ static bool doRename(const lstring& filepath, const lstring& filename) {
         else
             outListStream << logPrefix << qOldFile << logSep << qNewFile << logEndl;
     }
+}
+
+// ---------------------------------------------------------------------------
+// Open, read and parse file.
+static bool doRename(const lstring& filepath, const lstring& filename, const FileMeta& prefetchMeta) {
+    Stats::Timer timer(Stats::TRANSFORM);
+    releaseScopes(handledCnt++);
+    unsigned fileNum = (NumScope::scope != NumScope::SERIAL && !doDirectories) ? NumScope::next() : num;
+    lstring dirWithSlash, newFile;
+
+    // Fetch only metadata the -parts tokens need and the prefetch did not load.
+    FileMeta meta = prefetchMeta;
+    if (!meta.need(filepath, metaLevels)) {
+        Errors::add(meta.err, " read ", filepath, filepath, "");
+        return false;
+    }
+    
+    getNewName(newFile, dirWithSlash, filepath, filename, fileNum, meta);
+    writeList(dirWithSlash, filename, newFile);
 
     if (showFile)
-        std::cout << filepath << std::endl;
+        showFileMeta(filepath, meta);
     
     if (verbose && !dryRun) {
         std::cout << "Rename from=" << filepath << " to=" << newFile << std::endl;
     }
 
-    // Hash and NEW_FILES tries to avoid circular rename where AAAA -> 1111 and 1111 -> AAAA
+    if (CopyTo::enabled) {
+        CopyTo::add(filepath, newFile);
+        num++;
+        return true;
+    }
+
+    // newNames avoids circular rename where AAAA -> 1111 and 1111 -> AAAA
     // This condition can occur when doing recursive and * directory scans. 
-    size_t hashfilepath = HASH_STR(filepath);
-    size_t hashNewFile = HASH_STR(newFile);
+    if (Plan::enabled) {
+        // Nothing moves during the scan, applied by Plan::apply() afterwards.
+        bool okay = (filepath != newFile);
+        if (okay) {
+            Plan::add(filepath, newFile);
+            num++;      // next number, applied renames are counted by renameDone()
+        }
+        return okay;
+    }
+
+    std::string_view srcDir(dirWithSlash.data(), dirWithSlash.empty() ? 0 : dirWithSlash.length() - 1);
+    NameSet* srcScope = findScope(srcDir, false);
+    bool renamedBefore = srcScope != nullptr && srcScope->count(filename) != 0;
 
-    bool okay = (filepath != newFile && NEW_FILES.count(hashfilepath) == 0) && doRenameA(filepath, newFile);
+    bool okay = (filepath != newFile && !renamedBefore) && doRenameA(filepath, newFile);
     if (okay) {
         num++;
-        NEW_FILES.insert(hashNewFile);
+        std::string_view newPath = newFile.view();
+        size_t slash = newPath.rfind(Directory_files::SLASH_CHAR);
+        size_t nameStart = (slash == std::string::npos) ? 0 : slash + 1;
+        findScope(newPath.substr(0, nameStart == 0 ? 0 : slash), true)->emplace(newPath.substr(nameStart));
     }
+    if (Dedup::mode != Dedup::OFF)
+        Dedup::add((okay && !dryRun) ? newFile : filepath, meta);
     
     return okay;
 }
@@ -350,21 +891,184 @@ static bool doRename(const lstring& filepath, const lstring& filename) {
 // Open, read and parse file.
 static bool HandleFile(const lstring& filepath, const lstring& filename) {
     if (!doDirectories) {
-        return doRename(filepath, filename);
+        scannedCnt++;
+        if (Prefetch::enabled) {
+            Prefetch::add(filepath, filename);
+            return true;
+        }
+        return doRename(filepath, filename, FileMeta());
     }
     return false;
 }
 
+// ---------------------------------------------------------------------------
+// -D=threads, directories being scanned and renames done by PostOrder workers.
+static const unsigned POST_HOP = 2;     // case only rename via temp name
+static std::vector<std::pair<PostOrder::Dir*, lstring>> postDirs;
+static unsigned postQueued = 0;
+
+// ---------------------------------------------------------------------------
+// Rename on a worker thread. Paths are absolute since workers must not chdir and the
+// target check is the rename itself, the name cache belongs to the scan thread.
+static void postRename(const lstring& oldPath, const lstring& newPath, unsigned flags) {
+    lstring dir;
+    DirUtil::getDir(dir, newPath);
+    uint64_t startNs = Stats::wallNow();
+    int code = 0;
+    if (!dryRun) {
+        if (flags == POST_HOP) {
+            code = caseHop(oldPath, newPath);
+        } else {
+            IoRing::Op op { IoRing::Op::RENAME, oldPath, newPath, flags, nullptr, 0 };
+            IoRing::runSync(op);
+            code = (op.result == 0) ? 0 : -1;
+            errno = -op.result;
+        }
+    }
+    int err = errno;
+    renameDone(oldPath, newPath, dir, code, err, Stats::wallNow() - startNs);
+}
+
+// ---------------------------------------------------------------------------
+// Directory seen by the scan with -D=threads, new name is made here, rename is queued
+// until every directory below it is renamed.
+static bool postDir(const lstring& filepath, bool onEntry) {
+    PostOrder::Dir* parent = postDirs.empty() ? nullptr : postDirs.back().first;
+    if (onEntry) {
+        postDirs.push_back(std::make_pair(PostOrder::enter(parent), absPath(filepath)));
+        return false;
+    }
+
+    // Exit of a scanned directory, or a subdirectory listed without recursion.
+    lstring oldPath = absPath(filepath);
+    PostOrder::Dir* dir;
+    if (parent != nullptr && postDirs.back().second == oldPath) {
+        postDirs.pop_back();
+        dir = parent;
+    } else {
+        dir = PostOrder::enter(parent);
+    }
+
+    lstring name, dirWithSlash, newFile;
+    DirUtil::getName(name, oldPath);
+    FileMeta meta;
+    if (!meta.need(oldPath, metaLevels)) {
+        Errors::add(meta.err, " read ", oldPath, oldPath, "");
+    } else {
+        getNewName(newFile, dirWithSlash, oldPath, name, num + postQueued, meta);
+        if (newFile == oldPath)
+            newFile.clear();
+    }
+    if (newFile.empty()) {
+        PostOrder::leave(dir, oldPath, newFile, 0);
+        return false;
+    }
+
+    postQueued++;
+    writeList(dirWithSlash, name, newFile);
+    lstring parentDir;
+    DirUtil::getDir(parentDir, oldPath);
+    DirNames::CaseMode caseMode = caseOnlyMode(parentDir, oldPath, newFile);
+    unsigned flags = (caseMode == DirNames::FOLD_HOP) ? POST_HOP
+        : (force || caseMode != DirNames::EXACT) ? 0 : IoRing::NOREPLACE;
+    EventLog::write(EventLog::PLAN, oldPath, newFile);
+    PostOrder::leave(dir, oldPath, newFile, flags);
+    return true;
+}
+
 //-------------------------------------------------------------------------------------------------
 static bool HandleDir(const lstring& filepath, bool onEntry) {
+    if (doDirectories && PostOrder::threads != 0)
+        return postDir(filepath, onEntry);
+
+    bool okay = false;
     if (doDirectories && !onEntry) {
         // only do directory rename when recursion is exiting the directory level
-        lstring dir, name;
-        DirUtil::getDir(dir, filepath);
+        lstring name;
         DirUtil::getName(name, filepath);
-        return doRename(filepath, name);
+        scannedCnt++;
+        if (Prefetch::enabled) {
+            Prefetch::add(filepath, name);
+            okay = true;
+        } else {
+            okay = doRename(filepath, name, FileMeta());
+        }
     }
-    return false;
+    if (!onEntry) {
+        leftDirs.push_back(std::make_pair(scannedCnt, filepath));
+        releaseScopes(handledCnt);
+    }
+    return okay;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Parent directory of path, empty if none.
+static std::string_view parentOf(const lstring& path) {
+    size_t slash = path.rfind(Directory_files::SLASH_CHAR);
+    return std::string_view(path.data(), (slash == std::string::npos) ? 0 : slash);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Rename files listed in -files0-from without reading any directory. Each block of paths
+// is grouped by parent directory, keeping list order within a directory, so renames and
+// the name cache stay in one directory at a time.
+static void renameFromPaths(const lstring& listPath, Dirscan& dirscan) {
+    static const size_t GROUP_CNT = 4096;
+    PathList pathList;
+    if (!pathList.open(listPath)) {
+        Colors::showError("Failed to open -files0-from ", listPath, " ", strerror(errno));
+        return;
+    }
+
+    // Relative paths are made absolute, renames chdir to each directory.
+    std::vector<lstring> paths(GROUP_CNT);
+    std::vector<unsigned> order(GROUP_CNT);
+    lstring path;
+    size_t cnt = GROUP_CNT;
+    while (cnt == GROUP_CNT && !Signals::aborted) {
+        for (cnt = 0; cnt < GROUP_CNT && pathList.next(path); cnt++) {
+            paths[cnt] = absPath(path);
+            order[cnt] = (unsigned)cnt;
+        }
+        std::stable_sort(order.begin(), order.begin() + cnt, [&paths](unsigned lhs, unsigned rhs) {
+            return parentOf(paths[lhs]) < parentOf(paths[rhs]);
+        });
+
+        for (size_t idx = 0; idx < cnt && !Signals::aborted; idx++) {
+            const lstring& filePath = paths[order[idx]];
+            Progress::inc(Progress::scanned);
+            dirscan.FindFile(filePath);
+            // Directory group done, same as the scan leaving a directory.
+            if (idx + 1 == cnt || parentOf(paths[order[idx + 1]]) != parentOf(filePath)) {
+                leftDirs.push_back(std::make_pair(scannedCnt, lstring(parentOf(filePath))));
+                releaseScopes(handledCnt);
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Flush output lists, called at exit and by forced exit on third signal.
+static void flushLists() {
+    {
+        std::lock_guard<std::mutex> lock(outListMutex);
+        if (outListStream.is_open())
+            outListStream.flush();
+    }
+    Journal::flush();
+    EventLog::flush();
+}
+
+//-------------------------------------------------------------------------------------------------
+// Report what was applied before a cancel request.
+static void showCancelled() {
+    lstring lastOld, lastNew;
+    Journal::lastApplied(lastOld, lastNew);
+    Colors::showError("Cancelled, renames applied=", Journal::count());
+    if (!lastOld.empty())
+        Colors::showError("Last applied ", lastOld, "\n     to ", lastNew);
+    if (!Journal::path().empty())
+        Colors::showError("Applied renames listed in ", Journal::path());
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -379,21 +1083,37 @@ void showHelp(const char* arg0) {
         "   -_y_excludeItem=<filePattern>   ; Exclude files or dirs by regex match \n"
         "   -_y_IncludePath=<pathPattern>   ; Include path by regex match \n"
         "   -_y_ExcludePath=<pathPattern>   ; Exclude path by regex match \n"
-        "   -_y_D                           ; Rename directory \n"
+        "   -_y_D[=threads]                 ; Rename directory, threads rename subtrees in parallel \n"
         "   -_y_c/C                         ; lowercase or Uppercase \n"
         "   -_y_sub=<regexp>                ; substitute regexpression \n"
         "                                      /fromRexex/toRegex/ \n"
         "   -_y_parts=<fileParts>           ; See fileParts note below\n"
         "   -_y_startNum=1000               ; Start number, def=1 \n"
+        "   -_y_sort=name|natural|mtime|size ; Number files in sorted order per directory \n"
+        "   -_y_numScope=global|dir|ext     ; Number per scan, directory or extension \n"
         "   -_y_no                          ; No rename, dry run \n"
         "   -_y_force                       ; Deleted target if same name \n"
+#ifdef __linux__
+        "   -_y_uring                       ; Batch renames with io_uring \n"
+#endif
         "   -_y_recurse                     ; Recurse into directories \n"
+        "   -_y_progress[=count|<num>]      ; Show progress, count=pre-scan for ETA \n"
+        "   -_y_prefetch[=threads]          ; Stat files ahead of rename, def=2*cores \n"
         "   -_y_wide                        ; Wide char to utf-8\n"
         "\n"
         "   -_y_modify[=code]               ; Modify name (code=1..n < 64)) \n"
         "\n"
         "   -_y_toList=<write_fileName>     ; Output List of 'old','new' \n"
-        "   -_y_fromList=<read_fileName>    ; Read List rename pair per line \n"
+        "   -_y_json=<write_fileName>       ; Output NDJSON event per rename, - for stdout \n"
+        "   -_y_errorLog=<write_fileName>   ; Output every error, screen shows samples \n"
+        "   -_y_journal=<write_fileName>    ; Output applied 'old','new', undo with -fromList -2 \n"
+        "   -_y_fromList=<read_fileName>    ; Read List rename pair per line, applied as plan \n"
+        "   -_y_files0-from=<fileName|->    ; Read files to rename, NUL or newline delimited, - is stdin \n"
+        "   -_y_hashCache=<fileName>        ; Reuse {hash} of unchanged files across runs \n"
+        "   -_y_dedup[=link|clone]          ; Hardlink or clone duplicate files, def=link \n"
+        "   -_y_copyTo=<dir>                ; Copy to mirror tree with new names, keep originals \n"
+        "   -_y_memLimit=<size>             ; Plan all renames first in size memory, ex 512M, def=256M with -fromList \n"
+        "   -_y_planThreads=<num>           ; Workers applying plan, def=cores, 1=serial \n"
         " _P_Used with -fromList _X_ \n"
         "   -_y_1       [default]           ; Rename 'old' to 'new' \n"
         "   -_y_2                           ; Rename 'new' to 'old' \n"
@@ -408,10 +1128,14 @@ void showHelp(const char* arg0) {
         "     N-#.E \n"
         "     N_####.E \n"
         "     N.'foo' \n"
+        "     N_{mtime:%Y%m%d}.E     modify time, strftime format \n"
+        "     {exif:%Y%m%d-%H%M%S}.E  photo capture time, modify time if none \n"
+        "     N_{size}.E  N_{inode}.E  {hash}.E  {hash:8}.E  content xxHash64 hex digits\n"
     
         "\n"
         " _p_Debug:\n"
         "   -_y_showfiles                   ; Display files found \n"
+        "   -_y_stats                       ; Show phase timing and counters \n"
         "   -_y_verbose                     ; Only dump parsed json\n"
         "\n"
         " _p_Example: \n"
@@ -523,7 +1247,11 @@ bool is_not_ascii(wchar_t c) {
 // ---------------------------------------------------------------------------
 int main(int argc, char* argv[]) {
     Signals::init();
+    Signals::exitHook = flushLists;
+    Signals::progressHook = []() { Progress::show(true); };
+    Colors::init();
     ParseUtil parser;
+    bool prefetchSet = false;
     Dirscan dirscan(HandleDir, HandleFile);
     StringList extraDirList;
     
@@ -533,6 +1261,7 @@ int main(int argc, char* argv[]) {
     } else {
         getcwd(CWD_BUF, sizeof(CWD_BUF));
         CWD_LEN = (unsigned)strlen(CWD_BUF) + 1;
+        FileMeta::init();
 
         bool doParseCmds = true;
         string endCmds = "--";
@@ -549,12 +1278,47 @@ int main(int argc, char* argv[]) {
                     
                     const char* cmdName = cmd+1;
                     switch (*cmdName) {
+                    case 'D':   // -D=threads, rename directories in parallel bottom up
+                        doDirectories = true;
+                        PostOrder::threads = (unsigned)strtoul(value, nullptr, 10);
+                        break;
                     case 'e':   // -excludeItem=<pat>
-                        parser.validPattern(dirscan.excludeFilePatList, value, "excludeItem", cmdName);
+                        if (parser.validPattern(dirscan.excludeFilePatList, value, "excludeItem", cmdName, false)) {
+                        } else if (parser.validOption("errorLog", cmdName)) {
+                            if (!Errors::openLog(value)) {
+                                Colors::showError("Failed to open errorLog ", value, " ", strerror(errno));
+                                parser.optionErrCnt++;
+                            }
+                        }
                         break;
                     case 'E':   // -ExcludePath=<pat>
                         parser.validPattern(dirscan.excludeDirPatList, value, "ExcludePath", cmdName);
                         break;
+                    case 'h':   // -hashCache=<filepath>
+                        if (parser.validOption("hashCache", cmdName)) {
+                            if (!HashCache::open(value)) {
+                                Colors::showError("Failed to read hashCache ", value, " ", strerror(errno));
+                                parser.optionErrCnt++;
+                            }
+                        }
+                        break;
+                    case 'c':   // -copyTo=<dir>
+                        if (parser.validOption("copyTo", cmdName)) {
+                            copyToPath = value;
+                        }
+                        break;
+                    case 'd':   // -dedup=link|clone
+                        if (parser.validOption("dedup", cmdName)) {
+                            if (value == "link")
+                                Dedup::mode = Dedup::LINK;
+                            else if (value == "clone")
+                                Dedup::mode = Dedup::CLONE;
+                            else {
+                                Colors::showError("Unknown -dedup=", value, " expect link or clone");
+                                parser.optionErrCnt++;
+                            }
+                        }
+                        break;
                     case 'i':   // -includeItem=<pat>
                         parser.validPattern(dirscan.includeFilePatList, value, "includeItem", cmdName);
                         break;
@@ -562,11 +1326,28 @@ int main(int argc, char* argv[]) {
                         parser.validPattern(dirscan.includeDirPatList, value, "IncludePath", cmdName);
                         break;
                     case 'f':   // -fromList=<filepath>
-                        parser.validFile(inListStream, std::ios::in, inListPath=value, "fromList", cmdName);
+                        // fromList first, so -f keeps its meaning, -files0-from needs -fi.
+                        if (!parser.validFile(inListStream, std::ios::in, inListPath=value, "fromList", cmdName, false)) {
+                            if (parser.validOption("files0-from", cmdName))
+                                filesFromPath = value;
+                        }
                         break;
                     case 't':   // -toList=<filepath>
                         parser.validFile(outListStream, std::ios::out, outListPath=value, "tolist", cmdName);
                         break;
+                    case 'j':   // -json=<filepath>
+                        if (parser.validOption("journal", cmdName, false)) {
+                            if (!Journal::open(value)) {
+                                Colors::showError("Failed to open journal ", value, " ", strerror(errno));
+                                parser.optionErrCnt++;
+                            }
+                        } else if (parser.validOption("json", cmdName)) {
+                            if (!EventLog::open(value)) {
+                                Colors::showError("Failed to open json ", value, " ", strerror(errno));
+                                parser.optionErrCnt++;
+                            }
+                        }
+                        break;
                     case 'l':
                         if (parser.validOption("logStart", cmdName, false)) {
                             logPrefix = ParseUtil::convertSpecialChar(value);
@@ -577,22 +1358,50 @@ int main(int argc, char* argv[]) {
                         }
                         break;
                     case 'm':   // -modify=nn  Must enter full "modify" 
-                        if (strcmp("modify", cmdName) == 0) {   
+                        if (parser.validOption("memLimit", cmdName, false)) {
+                            if (!ParseUtil::getSize(value, Plan::memLimit) || Plan::memLimit == 0) {
+                                Colors::showError("Invalid memLimit ", value, ", expect size like 512M");
+                                parser.optionErrCnt++;
+                            }
+                        } else if (strcmp("modify", cmdName) == 0) {   
                             char* endStr;
                             modifyNum = (unsigned)std::strtol(value, &endStr, 10);
                         } else {
                             std::cerr << "To use modify, provide full name in switch, as -modify\n";
                         }
                         break;
+                    case 'n':   // -numScope=global|dir|ext
+                        if (parser.validOption("numScope", cmdName)) {
+                            if (!NumScope::parse(value)) {
+                                Colors::showError("Unknown -numScope=", value, ", use global, dir or ext");
+                                parser.optionErrCnt++;
+                            }
+                        }
+                        break;
                     case 'p':   // -parts="<format/sector>"
-                        if (parser.validOption("parts", cmdName)) {
+                        if (parser.validOption("parts", cmdName, false)) {
                             parts = ParseUtil::convertSpecialChar(value);
+                            metaLevels = ParseUtil::getPartsLevels(parts);
+                        } else if (strncasecmp(cmdName, "pre", 3) == 0 && parser.validOption("prefetch", cmdName, false)) {
+                            Prefetch::threads = (unsigned)strtoul(value, nullptr, 10);
+                            Prefetch::enabled = Prefetch::threads != 0;
+                            prefetchSet = true;
+                        } else if (parser.validOption("planThreads", cmdName, false)) {
+                            Plan::threads = (unsigned)strtoul(value, nullptr, 10);
+                        } else if (parser.validOption("progress", cmdName)) {
+                            progress = true;
+                            progressEst = value;
                         }
                         break;
                     case 's':   // substitute regexp, -sub=/fromPat/toPat/
                         if (parser.validOption("start", cmdName, false)) {
                             char* endStr;
                             num = (unsigned)std::strtol(value, &endStr, 10);
+                        } else if (parser.validOption("sort", cmdName, false)) {
+                            if (!SortOrder::parse(value, dirscan.sortBy)) {
+                                Colors::showError("Unknown -sort=", value, ", use name, natural, mtime or size");
+                                parser.optionErrCnt++;
+                            }
                         } else if (parser.validOption("substitute", cmdName)) {
                             Split parts(value.substr(1), value.substr(0, 1));
                             if (parts.size() == 3) { 
@@ -615,12 +1424,12 @@ int main(int argc, char* argv[]) {
                     const char* cmdName = argStr + 1;
                     switch (*cmdName) {
                     case 'v':   // verbose
-                        verbose = true;
+                        verbose = Errors::showAll = true;
                         break;
                     case 'n':   // dryRun
                         if (parser.validOption("noaction", cmdName)) {
                             std::cerr << "DryRun\n";
-                            verbose = dryRun = true;
+                            verbose = dryRun = Errors::showAll = true;
                         }
                         break;
                             
@@ -628,6 +1437,10 @@ int main(int argc, char* argv[]) {
                     case 'C':   // -C = uppercase
                         casefold = *cmdName;
                         break;
+                    case 'd':   // -dedup
+                        if (parser.validOption("dedup", cmdName))
+                            Dedup::mode = Dedup::LINK;
+                        break;
                     case 'D':   // -Directory = rename only directories
                         doDirectories = true;
                         std::cerr << "Renaming directories\n";
@@ -654,6 +1467,22 @@ int main(int argc, char* argv[]) {
                             std::cerr << "To use modify, provide full name in switch, as -modify\n";
                         }
                         break;
+                    case 'p':   // -progress
+                        // -p and -pr stay -progress, -prefetch needs at least -pre.
+                        if (strncasecmp(cmdName, "pre", 3) == 0 && parser.validOption("prefetch", cmdName, false)) {
+                            Prefetch::enabled = true;
+                            prefetchSet = true;
+                        } else {
+                            progress = parser.validOption("progress", cmdName);
+                        }
+                        break;
+                    case 'u':   // -uring
+                        if (parser.validOption("uring", cmdName)) {
+                            ioRing = new IoRing();
+                            if (!ioRing->isAsync())
+                                std::cerr << "io_uring not available, using synchronous rename\n";
+                        }
+                        break;
                     case 'r':   // -recurse
                         dirscan.recurse = true;
                         break;
@@ -661,6 +1490,8 @@ int main(int argc, char* argv[]) {
                     case 's': // SmartQuotes
                         if (parser.validOption("showFiles", cmdName, false)) {
                             showFile = true;
+                        } else if (parser.validOption("stats", cmdName, false)) {
+                            Stats::enabled = true;
                         } else if (parser.validOption("smartQuotes", cmdName)) {
                             smartQuote = true;
                         }
@@ -693,6 +1524,17 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        if (!copyToPath.empty() && !CopyTo::open(copyToPath, dryRun)) {
+            Colors::showError("Failed to create copyTo ", copyToPath, " ", strerror(errno));
+            parser.optionErrCnt++;
+        }
+
+        // -json=- keeps stdout for NDJSON only, human readable output goes to stderr.
+        if (EventLog::toStdout()) {
+            std::cout.rdbuf(std::cerr.rdbuf());
+            std::wcout.rdbuf(std::wcerr.rdbuf());
+        }
+
         if (verbose) {
             std::cout << "--- Settings ---\n";
             if (showFile) std::cout << "ShowFile\n";
@@ -701,6 +1543,7 @@ int main(int argc, char* argv[]) {
             if (invert) std::cout << "Invert list?\n";
             if (smartQuote) std::cout << "Smart Quotes\n";
             if (force) std::cout << "Force delete\n";
+            if (Stats::enabled) std::cout << "Stats\n";
             if (doDirectories) std::cout << "Do directories\n";
             if (dirscan.recurse) std::cout << "Recurse\n";
             if (casefold != '-') std::cout << "CaseFold=" << casefold << std::endl;
@@ -801,17 +1644,104 @@ int main(int argc, char* argv[]) {
         }
 #endif
 
+        if (CopyTo::enabled && (doDirectories || inListStream.is_open())) {
+            Colors::showError("-copyTo copies scanned files, not used with -D or -fromList");
+            parser.optionErrCnt++;
+        }
+        // A plain -fromList is applied as a plan by parallel workers. With -D the list
+        // may hold directories, a plan would rename a parent before its children.
+        if (inListStream.is_open() && extraDirList.empty() && filesFromPath.empty()
+                && Plan::memLimit == 0 && !doDirectories && Dedup::mode == Dedup::OFF) {
+            Plan::memLimit = LIST_MEM_LIMIT;
+        }
+        if (doDirectories && Plan::memLimit != 0) {
+            // Applied in source order a parent is renamed before its children.
+            Colors::showError("-memLimit plans file renames, not used with -D");
+            parser.optionErrCnt++;
+        }
+        if (Dedup::mode != Dedup::OFF && (CopyTo::enabled || Plan::memLimit != 0)) {
+            Colors::showError("-dedup checks files as they are renamed, not used with -copyTo or -memLimit");
+            parser.optionErrCnt++;
+        }
+        if (doDirectories && !filesFromPath.empty()) {
+            Colors::showError("-files0-from lists files, not used with -D");
+            parser.optionErrCnt++;
+        }
+
         if (parser.patternErrCnt == 0 && parser.optionErrCnt == 0) {
+            if (progress) {
+                if (progressEst == "count") {
+                    for (auto const& filePath : extraDirList)
+                        Progress::expected += Progress::preCount(filePath, dirscan.recurse);
+                } else if (!progressEst.empty()) {
+                    Progress::expected = strtoull(progressEst, nullptr, 10);
+                }
+                if (inListStream)
+                    Progress::expected += Progress::lineCount(inListPath);
+                Progress::start();
+            }
+            if (Dedup::mode != Dedup::OFF)
+                metaLevels |= FileMeta::bit(FileMeta::STAT);
+            // Metadata tokens and dedup turn on prefetch unless -prefetch=0.
+            if (metaLevels != 0 && !prefetchSet)
+                Prefetch::enabled = true;
+            Prefetch::levels = metaLevels | FileMeta::bit(FileMeta::STAT);
+            if (Prefetch::enabled)
+                Prefetch::start(doRename);
+            if (Plan::memLimit != 0 && !CopyTo::enabled)
+                Plan::open();
+            // Directories are renamed on exit, numbered in that order.
+            if (doDirectories)
+                NumScope::scope = NumScope::SERIAL;
+            if (Plan::enabled)
+                PostOrder::threads = 0;
+            if (doDirectories && PostOrder::threads != 0)
+                PostOrder::start(postRename);
+            NumScope::startNum = num;
+
             for (auto const& filePath : extraDirList)  {
+                if (CopyTo::enabled && !CopyTo::setRoot(filePath)) {
+                    Colors::showError("Skip ", filePath, ", copyTo directory is inside it");
+                    continue;
+                }
                 dirscan.FindFiles(filePath, 0);
             }
-
+            if (!filesFromPath.empty())
+                renameFromPaths(filesFromPath, dirscan);
+            Prefetch::stop();
+            PostOrder::stop();
+            CopyTo::finish();
             if (inListStream)  {
                 renameFromStream(inListStream);
             }
+            if (Plan::enabled) {
+                if (!Plan::apply(doRenameB, planFailed, planBarrier, planBatch, force ? nullptr : planTargetExists))
+                    Colors::showError("Failed plan temporary files ", strerror(errno));
+                Plan::close();
+            }
+            if (ioRing != nullptr) {
+                flushRenames();
+                delete ioRing;
+            }
+            finishMoves();
+            if (Dedup::mode != Dedup::OFF && !Signals::aborted) {
+                doChdir(CWD_BUF);   // scanned paths may be relative to start directory
+                Dedup::run(dryRun, verbose, Prefetch::threads);
+            }
+            Progress::stop();
         }
 
-        Colors::showError(doDirectories ? " Directories=" : " Files=", ( num - START_NUM ), " renamed");
+        unsigned doneCnt = CopyTo::enabled ? CopyTo::copied.load() : renamedCnt.load();
+        Colors::showError(doDirectories ? " Directories=" : " Files=", doneCnt, CopyTo::enabled ? " copied" : " renamed");
+        flushLists();
+        if (Signals::aborted)
+            showCancelled();
+        if (!HashCache::close())
+            Colors::showError("Failed to write hashCache ", strerror(errno));
+        Errors::report(std::cerr);
+        Stats::report(std::cerr);
+        EventLog::close();
+        Journal::close();
     }
 
     return 0;
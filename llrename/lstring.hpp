@@ -34,6 +34,7 @@
 
 
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <regex>        // ReplaceAll using regex
 
@@ -53,12 +54,15 @@ public:
 
     lstring(const lstring& rhs) : std::string(rhs)
     { }
-    lstring(const lstring&& rhs) noexcept  : std::string(rhs)
+    lstring(lstring&& rhs) noexcept  : std::string(std::move(rhs))
     { }
 
     lstring(const std::string& rhs) : std::string(rhs)
     { }
-    lstring(const std::string&& rhs) : std::string(rhs)
+    lstring(std::string&& rhs) noexcept : std::string(std::move(rhs))
+    { }
+
+    explicit lstring(std::string_view rhs) : std::string(rhs)
     { }
 
     std::string& toString()
@@ -71,6 +75,10 @@ public:
         return c_str();
     }
 
+    std::string_view view() const {
+        return std::string_view(data(), length());
+    }
+
     char back() const {
         return std::string::back();
     }
@@ -97,6 +105,26 @@ public:
         this->assign(rhs);
         return *this;
     }
+    lstring& operator=(lstring&& rhs) noexcept {
+        std::string::operator=(std::move(rhs));
+        return *this;
+    }
+    lstring& operator=(const std::string& rhs) {
+        this->assign(rhs);
+        return *this;
+    }
+    lstring& operator=(std::string&& rhs) noexcept {
+        std::string::operator=(std::move(rhs));
+        return *this;
+    }
+    lstring& operator=(const char* rhs) {
+        this->assign(rhs);
+        return *this;
+    }
+    lstring& operator=(std::string_view rhs) {
+        this->assign(rhs.data(), rhs.length());
+        return *this;
+    }
 
     lstring& toLower() {
         transform(begin(), end(), begin(),::tolower);
@@ -109,17 +137,40 @@ public:
 };
 
 
+// Concatenate with one allocation sized for the result.
+// Note: no char overloads, lstring + int is pointer offset via const char*.
+inline lstring concat(const char* lhs, size_t lhsLen, const char* rhs, size_t rhsLen) {
+    lstring result;
+    result.reserve(lhsLen + rhsLen);
+    result.append(lhs, lhsLen).append(rhs, rhsLen);
+    return result;
+}
+
 inline lstring operator+ (const lstring& lhs, const lstring& rhs) {
-    return lhs.toConstString() + rhs.toConstString();
+    return concat(lhs.data(), lhs.length(), rhs.data(), rhs.length());
 }
 inline std::string operator+ (const std::string& lhs, const lstring& rhs) {
     return lhs + rhs.toConstString();
 }
 inline lstring operator+ (const lstring& lhs, const std::string& rhs) {
-    return lhs.toConstString() + rhs;
+    return concat(lhs.data(), lhs.length(), rhs.data(), rhs.length());
 }
 inline lstring operator+ (const lstring& lhs, const char*   rhs) {
-    return lhs.toConstString() + rhs;
+    return concat(lhs.data(), lhs.length(), rhs, strlen(rhs));
+}
+
+// Left side is a temporary, append in place and move it along.
+inline lstring operator+ (lstring&& lhs, const lstring& rhs) {
+    lhs.append(rhs);
+    return std::move(lhs);
+}
+inline lstring operator+ (lstring&& lhs, const std::string& rhs) {
+    lhs.append(rhs);
+    return std::move(lhs);
+}
+inline lstring operator+ (lstring&& lhs, const char* rhs) {
+    lhs.append(rhs);
+    return std::move(lhs);
 }
 
 // ---------------------------------------------------------------------------
@@ -151,7 +202,6 @@ inline const lstring& ReplaceAll(lstring& subject,
 inline const lstring& ReplaceAll(lstring& subject,
     const std::regex & searchRE,
     const lstring& replace) {
-    std::string result = std::regex_replace(subject, searchRE, replace);
-    subject = result;
+    subject = std::regex_replace(subject, searchRE, replace);
     return subject;
 }
\ No newline at end of file
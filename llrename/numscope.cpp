@@ -0,0 +1,134 @@
+//-------------------------------------------------------------------------------------------------
+// File: numscope.cpp
+// Author: Dennis Lang
+//
+// Desc: Number scopes for -parts # numbering (-numScope)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "numscope.hpp"
+
+#include <string.h>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+NumScope::Scope NumScope::scope = NumScope::SERIAL;
+unsigned NumScope::startNum = 1;
+
+static std::unordered_map<std::string, unsigned> totals;    // group key, numbers used
+static std::deque<unsigned> numbers;                         // files handed to rename
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool NumScope::parse(const char* value) {
+    static const char* NAMES[] = { "global", "dir", "ext" };
+    static const Scope SCOPES[] = { GLOBAL, DIR, EXT };
+    for (unsigned idx = 0; idx < sizeof(NAMES) / sizeof(NAMES[0]); idx++) {
+        if (strcmp(value, NAMES[idx]) == 0) {
+            scope = SCOPES[idx];
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+static std::string_view groupKey(std::string_view name) {
+    if (NumScope::scope != NumScope::EXT)
+        return std::string_view();
+    size_t extPos = name.rfind('.');
+    return (extPos == std::string_view::npos) ? std::string_view() : name.substr(extPos + 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Reserve numbers for the matched files of one directory, in handling order.
+void NumScope::reserve(const PathTree& paths, const std::vector<PathTree::Node>& files,
+        std::vector<unsigned>& fileNums) {
+    // Count files per group of this directory.
+    std::vector<std::string_view> keys;
+    std::vector<unsigned> counts;
+    std::vector<unsigned> fileGroup(files.size());
+    for (size_t idx = 0; idx < files.size(); idx++) {
+        std::string_view key = groupKey(std::string_view(paths.name(files[idx]), paths.nameLen(files[idx])));
+        size_t group = 0;
+        while (group < keys.size() && keys[group] != key)
+            group++;
+        if (group == keys.size()) {
+            keys.push_back(key);
+            counts.push_back(0);
+        }
+        counts[group]++;
+        fileGroup[idx] = (unsigned)group;
+    }
+
+    // Exclusive prefix sum with the totals of earlier directories, counts become first numbers.
+    for (size_t group = 0; group < keys.size(); group++) {
+        unsigned count = counts[group];
+        if (scope == DIR) {
+            counts[group] = 0;
+        } else {
+            unsigned& total = totals[std::string(keys[group])];
+            counts[group] = total;
+            total += count;
+        }
+    }
+
+    fileNums.resize(files.size());
+    for (size_t idx = 0; idx < files.size(); idx++)
+        fileNums[idx] = startNum + counts[fileGroup[idx]]++;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+// Files given one at a time, DIR counts per parent directory.
+void NumScope::reserve(std::string_view path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string_view name = (slash == std::string_view::npos) ? path : path.substr(slash + 1);
+    std::string_view key = (scope == DIR) ? path.substr(0, path.length() - name.length()) : groupKey(name);
+    unsigned& total = totals[std::string(key)];
+    numbers.push_back(startNum + total++);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void NumScope::queue(unsigned number) {
+    numbers.push_back(number);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+unsigned NumScope::next() {
+    if (numbers.empty())
+        return startNum;
+    unsigned number = numbers.front();
+    numbers.pop_front();
+    return number;
+}
@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------------------------
+// File: numscope.hpp
+// Author: Dennis Lang
+//
+// Desc: Number scopes for -parts # numbering (-numScope)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+#include "pathtree.hpp"
+
+#include <string_view>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Numbers for -parts # fixed at scan time, instead of the count of renames done so far.
+// Each directory listing counts its matched files per group, then an exclusive prefix sum
+// over the running group totals gives the first number of each group in that directory:
+//   GLOBAL  one group, directories get consecutive blocks of numbers
+//   DIR     numbering restarts in every directory
+//   EXT     one group per extension across the whole scan
+// A file's number does not depend on when or whether earlier renames complete.
+// A directory keeps its reserved numbers while its subdirectories are scanned, each number
+// is queued as its file is handed to rename and next() takes them in that order.
+class NumScope {
+public:
+    enum Scope { SERIAL, GLOBAL, DIR, EXT };    // SERIAL counts completed renames
+
+    static Scope scope;
+    static unsigned startNum;
+
+    static bool parse(const char* value);       // global|dir|ext
+    static void reserve(const PathTree& paths, const std::vector<PathTree::Node>& files,
+            std::vector<unsigned>& fileNums);   // number of each file, in files order
+    static void reserve(std::string_view path); // file argument or listed path, queued now
+    static void queue(unsigned number);         // file handed to rename
+    static unsigned next();
+};
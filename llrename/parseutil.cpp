@@ -32,10 +32,15 @@
 #include <iostream>
 #include <fstream>
 #include <regex>
+#include <algorithm>
+#include <time.h>
 
 
 #ifdef HAVE_WIN
     #define strncasecmp _strnicmp
+    #include <io.h>
+#else
+    #include <unistd.h>
 #endif
 
 typedef unsigned int uint;
@@ -135,6 +140,35 @@ bool ParseUtil::FileMatches(const lstring& inName, const PatternList& patternLis
     return false;
 }
 
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool ParseUtil::getSize(const char* str, uint64_t& size) {
+    char* endPtr;
+    double value = strtod(str, &endPtr);
+    if (endPtr == str || value < 0)
+        return false;
+    switch (toupper(*endPtr)) {
+    case 'G':
+        value *= 1024;
+        // fall through
+    case 'M':
+        value *= 1024;
+        // fall through
+    case 'K':
+        value *= 1024;
+        endPtr++;
+        break;
+    case '\0':
+        break;
+    default:
+        return false;
+    }
+    if (toupper(*endPtr) == 'B')
+        endPtr++;
+    size = (uint64_t)value;
+    return *endPtr == '\0';
+}
+
 //-------------------------------------------------------------------------------------------------
 // Convert special characters from text to binary.
 // [static]
@@ -214,6 +248,85 @@ std::string& ParseUtil::fmtDateTime(string& outTmStr, time_t& now) {
     return outTmStr;
 }
 
+//-------------------------------------------------------------------------------------------------
+// Metadata tokens in -parts, {name} or {name:format}, with cost of fetching them.
+struct PartToken {
+    const char* name;
+    FileMeta::Level level;
+};
+static const PartToken PART_TOKENS[] = {
+    { "mtime", FileMeta::STAT },    // {mtime:%Y%m%d}  strftime format
+    { "size",  FileMeta::STAT },
+    { "inode", FileMeta::STAT },
+    { "exif",  FileMeta::HEADER },  // capture date, mtime if none
+    { "hash",  FileMeta::HASH },    // {hash:8}  hex digits, def=16
+};
+
+// Split {name:format} at fmt, return token or nullptr. Sets end past closing brace.
+static const PartToken* findToken(const char* fmt, string& format, const char*& end) {
+    const char* close = strchr(fmt, '}');
+    if (close == nullptr)
+        return nullptr;
+    end = close + 1;
+    string token(fmt + 1, close);
+    size_t colon = token.find(':');
+    format = (colon == string::npos) ? "" : token.substr(colon + 1);
+    token = token.substr(0, colon);
+    for (const PartToken& item : PART_TOKENS) {
+        if (token == item.name)
+            return &item;
+    }
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+unsigned ParseUtil::getPartsLevels(const char* partSelector) {
+    unsigned levels = 0;
+    string format;
+    for (const char* fmt = partSelector; *fmt; ) {
+        char c = *fmt;
+        if (c == '\'' || c == '"') {
+            const char* close = strchr(fmt + 1, c);
+            fmt = (close != nullptr) ? close + 1 : fmt + strlen(fmt);
+        } else if (c == '{') {
+            const char* end;
+            const PartToken* token = findToken(fmt, format, end);
+            if (token != nullptr) {
+                levels |= FileMeta::bit(token->level);
+                fmt = end;
+            } else {
+                fmt++;      // unknown {text} is literal, see getParts()
+            }
+        } else {
+            fmt++;
+        }
+    }
+    return levels;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Append value of metadata token.
+static void appendToken(string& outPart, const PartToken& token, const string& format, const FileMeta& meta) {
+    char buf[256];
+    const char* name = token.name;
+    if (strcmp(name, "size") == 0) {
+        snprintf(buf, sizeof(buf), "%llu", (unsigned long long)meta.size);
+    } else if (strcmp(name, "inode") == 0) {
+        snprintf(buf, sizeof(buf), "%llu", (unsigned long long)meta.inode);
+    } else if (strcmp(name, "hash") == 0) {
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)meta.hash);
+        unsigned width = format.empty() ? 16 : std::min((unsigned)atoi(format.c_str()), 16u);
+        buf[width] = '\0';
+    } else {
+        time_t when = (strcmp(name, "exif") == 0 && meta.hasExif) ? meta.exifTime : meta.mtime;
+        struct tm tmTime = *localtime(&when);
+        if (strftime(buf, sizeof(buf), format.empty() ? "%Y%m%d" : format.c_str(), &tmTime) == 0)
+            buf[0] = '\0';
+    }
+    outPart += buf;
+}
+
 //-------------------------------------------------------------------------------------------------
 // [static]
 string& ParseUtil::getParts(
@@ -221,7 +334,8 @@ string& ParseUtil::getParts(
         const char* partSelector,
         const char* name,       // just name, not extension
         const char* ext,        // just extension, no dot prefix
-        unsigned num) {
+        unsigned num,
+        const FileMeta* meta) { // loaded with getPartsLevels(), required if any
 
     unsigned width=0;
     char numFmt[10], numStr[10];
@@ -241,6 +355,19 @@ string& ParseUtil::getParts(
             case 'N':   // name
                 outPart += name;
                 break;
+            case '{':   // {token:format}
+                {
+                    string format;
+                    const char* end;
+                    const PartToken* token = findToken(fmt, format, end);
+                    if (token != nullptr && meta != nullptr) {
+                        appendToken(outPart, *token, format, *meta);
+                        fmt = end - 1;
+                    } else {
+                        outPart += *fmt;
+                    }
+                }
+                break;
             case '#':   // Size
                 width = 0;
                 while (*fmt++ == '#')
@@ -278,33 +405,89 @@ string& ParseUtil::getParts(
 #define WHITE  "\033[01;37m"
 #define OFF    "\033[00m"
 
+bool Colors::enabled = true;
+const char* Colors::errBeg = RED;
+const char* Colors::errEnd = OFF "\n";
 
-string Colors::colorize(const char* inStr) {
+struct ColorTag {
+    const char* tag;    // text between underscores
+    const char* color;
+};
+
+// _x_  where x lowercase, colorize following word
+static const ColorTag WORD_TAGS[] = {
+    { "y", YELLOW }, { "r", RED }, { "g", GREEN }, { "p", PINK }, { "lb", LBLUE }, { "w", WHITE } };
+// _X_  where X uppercase, colorize until _X_
+static const ColorTag SPAN_TAGS[] = {
+    { "Y", YELLOW }, { "R", RED }, { "G", GREEN }, { "P", PINK }, { "B", BLUE }, { "LB", LBLUE },
+    { "W", WHITE }, { "X", OFF } };
+
+inline static bool isWordChar(char c) {
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+// Return length of "_tag_" at inStr or 0 if no match.
+inline static size_t matchTag(const char* inStr, const char* tag) {
+    size_t tagLen = strlen(tag);
+    return (strncmp(inStr + 1, tag, tagLen) == 0 && inStr[tagLen + 1] == '_') ? tagLen + 2 : 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Colors::init() {
 #ifdef HAVE_WIN
-    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    DWORD dwMode = 0;
-    GetConsoleMode(hOut, &dwMode);
-    dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-    SetConsoleMode(hOut, dwMode);
+    enabled = _isatty(_fileno(stderr)) != 0;
+    if (enabled) {
+        DWORD dwMode = 0;
+        HANDLE hErr = GetStdHandle(STD_ERROR_HANDLE);
+        GetConsoleMode(hErr, &dwMode);
+        SetConsoleMode(hErr, dwMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+        GetConsoleMode(hOut, &dwMode);
+        SetConsoleMode(hOut, dwMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#else
+    enabled = isatty(fileno(stderr)) != 0;
 #endif
-    string str(inStr);
-
-    // _x_  where x lowercase, colorize following word
-    replaceRE(str, "_y_(\\w+)", YELLOW "$1" OFF);
-    replaceRE(str, "_r_(\\w+)", RED "$1" OFF);
-    replaceRE(str, "_g_(\\w+)", GREEN "$1" OFF);
-    replaceRE(str, "_p_(\\w+)", PINK "$1" OFF);
-    replaceRE(str, "_lb_(\\w+)", LBLUE "$1" OFF);
-    replaceRE(str, "_w_(\\w+)", WHITE "$1" OFF);
-
-    // _X_  where X uppercase, colorize until _X_
-    replaceRE(str, "_Y_", YELLOW);
-    replaceRE(str, "_R_", RED);
-    replaceRE(str, "_G_", GREEN);
-    replaceRE(str, "_P_", PINK);
-    replaceRE(str, "_B_", BLUE);
-    replaceRE(str, "_LB_", LBLUE);
-    replaceRE(str, "_W_", WHITE);
-    replaceRE(str, "_X_", OFF);
+    errBeg = enabled ? RED : "";
+    errEnd = enabled ? OFF "\n" : "\n";
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Replace color markup in one pass.
+string Colors::colorize(const char* inStr) {
+    string str;
+    str.reserve(strlen(inStr) + 64);
+
+    while (*inStr) {
+        size_t tagLen = 0;
+        if (*inStr == '_') {
+            for (const ColorTag& item : WORD_TAGS) {
+                if ((tagLen = matchTag(inStr, item.tag)) != 0 && isWordChar(inStr[tagLen])) {
+                    const char* word = inStr + tagLen;
+                    const char* wordEnd = word;
+                    while (isWordChar(*wordEnd))
+                        wordEnd++;
+                    if (enabled) str += item.color;
+                    str.append(word, wordEnd - word);
+                    if (enabled) str += OFF;
+                    inStr = wordEnd;
+                    break;
+                }
+                tagLen = 0;
+            }
+            if (tagLen == 0) {
+                for (const ColorTag& item : SPAN_TAGS) {
+                    if ((tagLen = matchTag(inStr, item.tag)) != 0) {
+                        if (enabled) str += item.color;
+                        inStr += tagLen;
+                        break;
+                    }
+                }
+            }
+        }
+        if (tagLen == 0)
+            str += *inStr++;
+    }
     return str;
 }
@@ -33,10 +33,12 @@
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "ll_stdhdr.hpp"
+#include "filemeta.hpp"
 
 #include <regex>
 #include <set>
 #include <iostream>
+#include <sstream>
 
 typedef std::vector<std::regex> PatternList;
 
@@ -62,12 +64,17 @@ public:
     static bool FileMatches(const lstring& inName, const PatternList& patternList, bool emptyResult);
     static const char* convertSpecialChar(const char* inPtr);
     static std::string& fmtDateTime(string& outTmStr, time_t& now);
+    // Size with optional K, M or G suffix (1024 based), false if not a number.
+    static bool getSize(const char* str, uint64_t& size);
     static string& getParts(
             string& outPart,
             const char* partSelector,
             const char* name,
             const char* ext,
-            unsigned num );
+            unsigned num,
+            const FileMeta* meta = nullptr);
+    // FileMeta::bit() mask of levels referenced by {token} parts, other {text} is literal.
+    static unsigned getPartsLevels(const char* partSelector);
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -131,15 +138,24 @@ inline string& replaceRE(string& inOut, const char* findRE, const char* replaceW
 //-------------------------------------------------------------------------------------------------
 class Colors {
 public:
+    // Color markup is rendered in a single pass, markup is stripped when disabled.
+    static bool enabled;
+    static const char* errBeg;  // rendered "_R_"
+    static const char* errEnd;  // rendered "_X_\n"
+
+    // Enable colors only if stderr is a terminal.
+    static void init();
     static string colorize(const char* inStr);
 
     // Requires C++ v17+
     // Show error in RED
     template<typename T, typename... Args>
     static void showError(T first, Args... args) {
-        std::cerr << Colors::colorize("_R_");
-        std::cerr << first;
-        ( ( std::cerr << args << " " ), ... );
-        std::cerr << Colors::colorize("_X_\n");
+        // Format first, so message is one write on unbuffered stderr.
+        std::ostringstream msg;
+        msg << errBeg << first;
+        ( ( msg << args << " " ), ... );
+        msg << errEnd;
+        std::cerr << msg.str();
     }
 };
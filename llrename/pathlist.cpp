@@ -0,0 +1,117 @@
+//-------------------------------------------------------------------------------------------------
+// File: pathlist.cpp
+// Author: Dennis Lang
+//
+// Desc: Read NUL or newline delimited paths (-files0-from)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "pathlist.hpp"
+#include "stats.hpp"
+
+#include <string.h>
+
+#ifdef HAVE_WIN
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+//-------------------------------------------------------------------------------------------------
+PathList::PathList() : file(nullptr), pos(0), end(0), delim('\n'), atEof(false) {
+}
+
+//-------------------------------------------------------------------------------------------------
+PathList::~PathList() {
+    if (file != nullptr && file != stdin)
+        fclose(file);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool PathList::open(const char* path) {
+    if (strcmp(path, "-") == 0) {
+#ifdef HAVE_WIN
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+        file = stdin;
+    } else {
+        file = fopen(path, "rb");
+    }
+    if (file == nullptr)
+        return false;
+
+    buf.resize(BLOCK_SIZE);
+    fill();
+    if (memchr(buf.data(), '\0', end) != nullptr)
+        delim = '\0';
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Move unread tail to front and read more, grows buffer for a path longer than a block.
+bool PathList::fill() {
+    if (atEof)
+        return false;
+    Stats::Timer timer(Stats::LIST_IO);
+    if (pos != 0) {
+        memmove(buf.data(), buf.data() + pos, end - pos);
+        end -= pos;
+        pos = 0;
+    }
+    if (end == buf.size())
+        buf.resize(buf.size() * 2);
+    size_t got = fread(buf.data() + end, 1, buf.size() - end, file);
+    end += got;
+    if (got == 0)
+        atEof = true;
+    return got != 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool PathList::next(lstring& path) {
+    while (true) {
+        const char* found = (const char*)memchr(buf.data() + pos, delim, end - pos);
+        if (found == nullptr && fill())
+            continue;
+        if (found == nullptr && pos == end)
+            return false;
+
+        // Taken after fill(), which moves the unread tail to the front at end of file.
+        const char* beg = buf.data() + pos;
+
+        size_t len = (found != nullptr) ? found - beg : end - pos;
+        pos += (found != nullptr) ? len + 1 : len;
+        if (delim == '\n' && len != 0 && beg[len - 1] == '\r')
+            len--;
+        if (len != 0) {
+            path.assign(beg, len);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------------------------------
+// File: pathlist.hpp
+// Author: Dennis Lang
+//
+// Desc: Read NUL or newline delimited paths (-files0-from)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <stdio.h>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Paths from a file or stdin, for lists made by find -print0, a database or a manifest.
+// Paths are split on NUL if the first block read has one, else on newline (a trailing
+// carriage return is dropped). Reads in large blocks, a path is copied out only once.
+class PathList {
+public:
+    static const size_t BLOCK_SIZE = 1 << 20;
+
+    PathList();
+    ~PathList();
+
+    bool open(const char* path);    // "-" is stdin
+    bool next(lstring& path);       // false at end, skips empty entries
+
+private:
+    PathList(const PathList&);
+    bool fill();
+
+    FILE* file;
+    std::vector<char> buf;
+    size_t pos;
+    size_t end;
+    char delim;
+    bool atEof;
+};
@@ -0,0 +1,102 @@
+//-------------------------------------------------------------------------------------------------
+// File: pathtree.cpp
+// Author: Dennis Lang
+//
+// Desc: Arena allocated directory tree of name spans
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "pathtree.hpp"
+#include "directory.hpp"
+
+//-------------------------------------------------------------------------------------------------
+PathTree::PathTree() : blockIdx(0), blockUsed(0) {
+    blocks.push_back(new char[BLOCK_SIZE]);
+}
+
+//-------------------------------------------------------------------------------------------------
+PathTree::~PathTree() {
+    for (char* block : blocks)
+        delete[] block;
+}
+
+//-------------------------------------------------------------------------------------------------
+PathTree::Node PathTree::add(Node parent, const char* name, size_t len, bool isDir) {
+    if (len >= BLOCK_SIZE)
+        len = BLOCK_SIZE - 1;
+    if (blockUsed + len + 1 > BLOCK_SIZE) {
+        // Next block, reuse blocks kept by release().
+        if (++blockIdx == blocks.size())
+            blocks.push_back(new char[BLOCK_SIZE]);
+        blockUsed = 0;
+    }
+    char* dst = blocks[blockIdx] + blockUsed;
+    memcpy(dst, name, len);
+    dst[len] = '\0';
+    blockUsed += len + 1;
+
+    nodes.push_back(Entry { dst, parent, (uint32_t)(len << 1) | (isDir ? 1 : 0) });
+    return (Node)(nodes.size() - 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Two passes up the parent chain, size the path then fill it from the end.
+const lstring& PathTree::path(Node node, lstring& outPath) const {
+    size_t length = 0;
+    Node at;
+    for (at = node; nodes[at].parent != NONE; at = nodes[at].parent)
+        length += nameLen(at) + 1;
+    size_t rootLen = nameLen(at);
+    if (at != node && rootLen != 0 && name(at)[rootLen - 1] == Directory_files::SLASH_CHAR)
+        rootLen--;      // root "/" or "c:\"
+    length += rootLen;
+
+    outPath.resize(length);
+    size_t pos = length;
+    for (at = node; nodes[at].parent != NONE; at = nodes[at].parent) {
+        pos -= nameLen(at);
+        memcpy(&outPath[pos], name(at), nameLen(at));
+        outPath[--pos] = Directory_files::SLASH_CHAR;
+    }
+    memcpy(&outPath[0], name(at), rootLen);
+    return outPath;
+}
+
+//-------------------------------------------------------------------------------------------------
+PathTree::Mark PathTree::mark() const {
+    return Mark { nodes.size(), blockIdx, blockUsed };
+}
+
+//-------------------------------------------------------------------------------------------------
+void PathTree::release(const Mark& mark) {
+    nodes.resize(mark.nodeCnt);
+    blockIdx = mark.blockIdx;
+    blockUsed = mark.blockUsed;
+}
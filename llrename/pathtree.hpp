@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------------------------------
+// File: pathtree.hpp
+// Author: Dennis Lang
+//
+// Desc: Arena allocated directory tree of name spans
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Tree of scanned entries. A node is a parent index plus a name span in an arena of large
+// blocks, about 16 bytes plus the name, instead of a full path string per entry.
+// Full paths are built only when a system call or callback needs one.
+// Nodes are released in LIFO order (see mark/release) as the scanner leaves a directory,
+// so memory holds the listings along the current directory path only.
+class PathTree {
+public:
+    typedef uint32_t Node;
+    static const Node NONE = 0xffffffff;
+
+    struct Mark {
+        size_t nodeCnt;
+        size_t blockIdx;
+        size_t blockUsed;
+    };
+
+    PathTree();
+    ~PathTree();
+
+    // Add child of parent, parent NONE adds a root whose name is the full directory path.
+    Node add(Node parent, const char* name, size_t len, bool isDir);
+
+    const char* name(Node node) const   { return nodes[node].name; }
+    size_t nameLen(Node node) const     { return nodes[node].lenDir >> 1; }
+    bool isDir(Node node) const         { return (nodes[node].lenDir & 1) != 0; }
+    Node parent(Node node) const        { return nodes[node].parent; }
+    size_t size() const                 { return nodes.size(); }
+
+    // Full path of node joined with slashes, reuses outPath capacity.
+    const lstring& path(Node node, lstring& outPath) const;
+
+    Mark mark() const;
+    void release(const Mark& mark);     // drop nodes and names added after mark
+
+private:
+    PathTree(const PathTree&);
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    struct Entry {
+        const char* name;
+        Node parent;
+        uint32_t lenDir;    // name length << 1 | isDir
+    };
+    std::vector<Entry> nodes;
+    std::vector<char*> blocks;
+    size_t blockIdx;
+    size_t blockUsed;
+};
@@ -0,0 +1,504 @@
+//-------------------------------------------------------------------------------------------------
+// File: plan.cpp
+// Author: Dennis Lang
+//
+// Desc: Out of core rename plan, external sort of rename records (-memLimit)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "plan.hpp"
+#include "directory.hpp"
+#include "parseutil.hpp"
+#include "signals.hpp"
+#include "stats.hpp"
+#include "threadpool.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_set>
+
+#ifdef HAVE_WIN
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+bool Plan::enabled = false;
+Plan::Pass Plan::pass = Plan::NO_PASS;
+static char hopExt[32] = ".llplan";
+const char* Plan::HOP_EXT = hopExt;     // with pid, a name left by an earlier run is no hop
+uint64_t Plan::memLimit = 0;
+unsigned Plan::threads = 0;
+
+static const size_t FAN_IN = 64;            // runs merged at once
+static const size_t RECORD_OVERHEAD = 64;   // vector slot and string headers
+static const size_t BATCH_CNT = 256;        // renames per worker batch
+
+struct Record {
+    std::string oldName;
+    std::string newName;
+    uint64_t seq;
+    uint8_t hop;            // rename via temporary name
+};
+
+static std::vector<Record> records;
+static size_t recordBytes = 0;
+static uint64_t nextSeq = 0;
+static lstring tmpBase;
+static unsigned tmpCnt = 0;
+static std::vector<lstring> tmpFiles;       // every file created, removed by close()
+static std::vector<lstring> byNewRuns;      // spilled runs sorted by target
+
+//-------------------------------------------------------------------------------------------------
+// Order by directory then name, so a directory's entries are adjacent in a run.
+static int pathCompare(const std::string& path1, const std::string& path2) {
+    size_t slash1 = path1.rfind(Directory_files::SLASH_CHAR);
+    size_t slash2 = path2.rfind(Directory_files::SLASH_CHAR);
+    size_t dirLen1 = (slash1 == std::string::npos) ? 0 : slash1;
+    size_t dirLen2 = (slash2 == std::string::npos) ? 0 : slash2;
+    int cmp = path1.compare(0, dirLen1, path2, 0, dirLen2);
+    if (cmp != 0)
+        return cmp;
+    return path1.compare(dirLen1, std::string::npos, path2, dirLen2, std::string::npos);
+}
+
+static bool lessByNew(const Record& rec1, const Record& rec2) {
+    int cmp = pathCompare(rec1.newName, rec2.newName);
+    return (cmp != 0) ? cmp < 0 : rec1.seq < rec2.seq;
+}
+
+static bool lessByOld(const Record& rec1, const Record& rec2) {
+    return pathCompare(rec1.oldName, rec2.oldName) < 0;
+}
+
+typedef bool (*Less_t)(const Record&, const Record&);
+
+//-------------------------------------------------------------------------------------------------
+// Run file of length prefixed records.
+static bool writeRecord(FILE* out, const Record& rec) {
+    uint32_t len1 = (uint32_t)rec.oldName.length();
+    uint32_t len2 = (uint32_t)rec.newName.length();
+    return fwrite(&len1, sizeof(len1), 1, out) == 1
+        && fwrite(rec.oldName.data(), 1, len1, out) == len1
+        && fwrite(&len2, sizeof(len2), 1, out) == 1
+        && fwrite(rec.newName.data(), 1, len2, out) == len2
+        && fwrite(&rec.seq, sizeof(rec.seq), 1, out) == 1
+        && fwrite(&rec.hop, sizeof(rec.hop), 1, out) == 1;
+}
+
+static bool readRecord(FILE* in, Record& rec) {
+    uint32_t len;
+    if (fread(&len, sizeof(len), 1, in) != 1)
+        return false;
+    rec.oldName.resize(len);
+    if (fread(&rec.oldName[0], 1, len, in) != len || fread(&len, sizeof(len), 1, in) != 1)
+        return false;
+    rec.newName.resize(len);
+    return fread(&rec.newName[0], 1, len, in) == len
+        && fread(&rec.seq, sizeof(rec.seq), 1, in) == 1
+        && fread(&rec.hop, sizeof(rec.hop), 1, in) == 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+static FILE* createTmp(lstring& path) {
+    char num[32];
+    snprintf(num, sizeof(num), "%u", tmpCnt++);
+    path = tmpBase + num;
+    FILE* out = fopen(path, "wb");
+    if (out != nullptr)
+        tmpFiles.push_back(path);
+    return out;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Sort records in memory and write them as a run.
+static bool spill(std::vector<Record>& recs, Less_t less, std::vector<lstring>& runs) {
+    Stats::Timer timer(Stats::LIST_IO);
+    std::sort(recs.begin(), recs.end(), less);
+    lstring path;
+    FILE* out = createTmp(path);
+    if (out == nullptr)
+        return false;
+    bool okay = true;
+    for (const Record& rec : recs)
+        okay = okay && writeRecord(out, rec);
+    okay = (fclose(out) == 0) && okay;
+    runs.push_back(path);
+    recs.clear();
+    return okay;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Merge runs into one sorted stream, calling emit(record) in order. More runs than FAN_IN are
+// first merged in groups, so open files and read buffers stay within the budget.
+typedef std::function<bool(const Record&)> Emit_t;
+static bool mergeRuns(std::vector<lstring>& runs, Less_t less, const Emit_t& emit) {
+    Stats::Timer timer(Stats::LIST_IO);
+    while (runs.size() > FAN_IN) {
+        std::vector<lstring> merged;
+        for (size_t off = 0; off < runs.size(); off += FAN_IN) {
+            std::vector<lstring> group(runs.begin() + off, runs.begin() + std::min(off + FAN_IN, runs.size()));
+            lstring path;
+            FILE* out = createTmp(path);
+            if (out == nullptr)
+                return false;
+            bool okay = mergeRuns(group, less, [out](const Record& rec) { return writeRecord(out, rec); });
+            okay = (fclose(out) == 0) && okay;
+            if (!okay)
+                return false;
+            merged.push_back(path);
+        }
+        runs.swap(merged);
+    }
+
+    std::vector<FILE*> files;
+    std::vector<Record> heads(runs.size());
+    std::vector<size_t> heap;       // run index, min heap on heads
+    auto greater = [&](size_t idx1, size_t idx2) { return less(heads[idx2], heads[idx1]); };
+    bool okay = true;
+    for (size_t idx = 0; idx < runs.size(); idx++) {
+        FILE* in = fopen(runs[idx], "rb");
+        files.push_back(in);
+        if (in == nullptr) {
+            okay = false;
+            continue;
+        }
+        if (readRecord(in, heads[idx]))
+            heap.push_back(idx);
+    }
+    std::make_heap(heap.begin(), heap.end(), greater);
+    while (okay && !heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        size_t idx = heap.back();
+        okay = emit(heads[idx]);
+        if (readRecord(files[idx], heads[idx]))
+            std::push_heap(heap.begin(), heap.end(), greater);
+        else
+            heap.pop_back();
+    }
+    for (FILE* in : files)
+        if (in != nullptr)
+            fclose(in);
+    for (const lstring& path : runs)
+        remove(path);       // consumed, free disk space early
+    runs.clear();
+    return okay;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool Plan::open(const char* tmpDir) {
+    if (tmpDir == nullptr)
+        tmpDir = getenv("TMPDIR");
+#ifdef HAVE_WIN
+    if (tmpDir == nullptr)
+        tmpDir = getenv("TEMP");
+    if (tmpDir == nullptr)
+        tmpDir = ".";
+#else
+    if (tmpDir == nullptr)
+        tmpDir = "/tmp";
+#endif
+    char name[64];
+    snprintf(name, sizeof(name), "llrename-plan-%u-", (unsigned)getpid());
+    snprintf(hopExt, sizeof(hopExt), ".llplan%u", (unsigned)getpid());
+    DirUtil::join(tmpBase, tmpDir, name);
+    records.reserve(1024);
+    enabled = true;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Plan::add(const char* oldName, const char* newName) {
+    records.push_back(Record { oldName, newName, nextSeq++, 0 });
+    recordBytes += records.back().oldName.length() + records.back().newName.length() + RECORD_OVERHEAD;
+    if (recordBytes >= memLimit / 2) {
+        if (!spill(records, lessByNew, byNewRuns))
+            Colors::showError("Failed to write plan ", tmpBase, "* ", strerror(errno));
+        recordBytes = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+size_t Plan::size() {
+    return (size_t)nextSeq;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool Plan::apply(Rename_t rename, Failed_t failed, Barrier_t barrier, Batch_t batchRename, Exists_t targetExists) {
+    if (!records.empty() && !spill(records, lessByNew, byNewRuns))
+        return false;
+    std::vector<Record>().swap(records);
+    recordBytes = 0;
+
+    // 1. Merge by target, first source wins. Winners go to the target list (already in
+    //    target order) and to new runs sorted by source.
+    lstring targetPath;
+    FILE* targets = createTmp(targetPath);
+    if (targets == nullptr)
+        return false;
+    std::vector<lstring> byOldRuns;
+    std::string lastNew;
+    bool haveLast = false;
+    bool okay = mergeRuns(byNewRuns, lessByNew, [&](const Record& rec) {
+        if (haveLast && rec.newName == lastNew) {
+            failed(rec.oldName.c_str(), rec.newName.c_str(), EEXIST);
+            return true;
+        }
+        lastNew = rec.newName;
+        haveLast = true;
+        records.push_back(rec);
+        recordBytes += rec.oldName.length() + rec.newName.length() + RECORD_OVERHEAD;
+        if (recordBytes >= memLimit / 2) {
+            recordBytes = 0;
+            if (!spill(records, lessByOld, byOldRuns))
+                return false;
+        }
+        return writeRecord(targets, rec);
+    });
+    okay = (fclose(targets) == 0) && okay;
+    if (okay && !records.empty())
+        okay = spill(records, lessByOld, byOldRuns);
+    std::vector<Record>().swap(records);
+    recordBytes = 0;
+    if (!okay)
+        return false;
+
+    // 2. Merge by source, joined with the sorted targets, to mark sources which are targets.
+    //    Other targets are checked in batches, an existing one drops its source.
+    std::unordered_set<std::string> dropped;    // sources which keep their name
+    std::vector<Pair> checks;
+    auto checkTargets = [&]() {
+        if (checks.empty())
+            return;
+        targetExists(checks);
+        for (const Pair& pair : checks) {
+            if (!pair.okay) {
+                failed(pair.oldName, pair.newName, EEXIST);
+                dropped.insert(pair.oldName);
+            }
+        }
+        checks.clear();
+    };
+    auto freeTarget = [&](const Record& rec) {
+        if (targetExists == nullptr)
+            return;
+        checks.push_back(Pair { lstring(rec.oldName), lstring(rec.newName), true });
+        if (checks.size() >= BATCH_CNT)
+            checkTargets();
+    };
+
+    lstring planPath;
+    FILE* plan = createTmp(planPath);
+    targets = fopen(targetPath, "rb");
+    if (plan == nullptr || targets == nullptr) {
+        if (plan != nullptr)
+            fclose(plan);
+        return false;
+    }
+    Record target;
+    bool haveTarget = readRecord(targets, target);
+    bool targetIsSource = false;
+    okay = mergeRuns(byOldRuns, lessByOld, [&](const Record& rec) {
+        int cmp = -1;
+        while (haveTarget && (cmp = pathCompare(target.newName, rec.oldName)) < 0) {
+            if (!targetIsSource)
+                freeTarget(target);
+            targetIsSource = false;
+            haveTarget = readRecord(targets, target);
+        }
+        Record out = rec;
+        out.hop = (haveTarget && cmp == 0) ? 1 : 0;
+        targetIsSource = targetIsSource || out.hop != 0;
+        return writeRecord(plan, out);
+    });
+    for (; okay && haveTarget; haveTarget = readRecord(targets, target)) {
+        if (!targetIsSource)
+            freeTarget(target);
+        targetIsSource = false;
+    }
+    checkTargets();
+    fclose(targets);
+    okay = (fclose(plan) == 0) && okay;
+    if (!okay)
+        return false;
+
+    // A dropped source keeps its name, so a rename onto it fails too, repeat along chains.
+    for (size_t droppedCnt = 0; droppedCnt != dropped.size(); ) {
+        droppedCnt = dropped.size();
+        plan = fopen(planPath, "rb");
+        if (plan == nullptr)
+            return false;
+        Record rec;
+        while (readRecord(plan, rec)) {
+            if (dropped.count(rec.newName) != 0 && dropped.insert(rec.oldName).second)
+                failed(rec.oldName.c_str(), rec.newName.c_str(), EEXIST);
+        }
+        fclose(plan);
+    }
+
+    // 3. Apply in source order, hops first so chained and swapped targets are free.
+    //    A cancel skips the direct pass, but hops already started always reach their target.
+    lstring hopName;
+    size_t hopsStarted = 0;
+    std::unordered_set<std::string> hopsFailed;
+    std::vector<std::string> hopsBack;      // temporary names whose target rename failed
+    std::mutex failMutex;
+    std::unique_ptr<ThreadPool> pool((batchRename != nullptr && threads != 1) ? new ThreadPool(threads) : nullptr);
+    std::vector<Pair> batch;
+    std::string lastDir;                    // directory of previous batch
+    std::shared_future<void> lastDone;
+
+    // Hand batch of one source directory to a worker, failed hops are kept for pass 2.
+    // Renames in one directory serialize on its lock in the kernel, so a batch waits for the
+    // previous batch of the same directory and workers spread over directories.
+    auto flush = [&](int pass) {
+        if (batch.empty())
+            return;
+        std::shared_ptr<std::vector<Pair>> work = std::make_shared<std::vector<Pair>>(std::move(batch));
+        batch.clear();
+        const lstring& first = work->front().oldName;
+        size_t dirLen = first.rfind(Directory_files::SLASH_CHAR);
+        std::string dir = first.substr(0, (dirLen == std::string::npos) ? 0 : dirLen);
+        std::shared_future<void> prevDone = (dir == lastDir) ? lastDone : std::shared_future<void>();
+        std::shared_ptr<std::promise<void>> done = std::make_shared<std::promise<void>>();
+        lastDir = dir;
+        lastDone = done->get_future().share();
+        pool->add([work, pass, batchRename, prevDone, done, &failMutex, &hopsFailed, &hopsBack]() {
+            if (prevDone.valid())
+                prevDone.wait();
+            batchRename(*work);
+            if (pass != 1) {
+                std::lock_guard<std::mutex> lock(failMutex);
+                for (const Pair& pair : *work) {
+                    if (!pair.okay && pass == 0)
+                        hopsFailed.insert(pair.oldName);
+                    else if (!pair.okay)
+                        hopsBack.push_back(pair.oldName);
+                }
+            }
+            done->set_value();
+        });
+    };
+    auto renameOne = [&](const std::string& oldName, const char* newName, int pass) {
+        if (pool == nullptr) {
+            if (!rename(oldName.c_str(), newName)) {
+                if (pass == 0)
+                    hopsFailed.insert(oldName);
+                else if (pass == 2)
+                    hopsBack.push_back(oldName);
+            }
+            return;
+        }
+        if (!batch.empty()) {
+            const lstring& last = batch.back().oldName;
+            size_t dirLen = last.rfind(Directory_files::SLASH_CHAR);
+            bool sameDir = (dirLen == oldName.rfind(Directory_files::SLASH_CHAR))
+                && oldName.compare(0, dirLen, last, 0, dirLen) == 0;
+            if (batch.size() >= BATCH_CNT || !sameDir)
+                flush(pass);
+        }
+        batch.push_back(Pair { lstring(oldName), lstring(newName), false });
+    };
+
+    for (int pass = 0; pass < 3; pass++) {
+        if (Signals::aborted && pass == 1)
+            continue;
+        Plan::pass = (Pass)(pass + 1);
+        plan = fopen(planPath, "rb");
+        if (plan == nullptr) {
+            Plan::pass = NO_PASS;
+            return false;
+        }
+        Record rec;
+        size_t hopCnt = 0;
+        while (readRecord(plan, rec)) {
+            if (pass != 2 && Signals::aborted)
+                break;
+            if (!dropped.empty() && dropped.count(rec.oldName) != 0)
+                continue;
+            hopName = rec.oldName;
+            hopName += HOP_EXT;
+            if (rec.hop) {
+                if (pass == 0) {
+                    hopsStarted++;
+                    renameOne(rec.oldName, hopName, pass);
+                } else if (pass == 2) {
+                    if (hopCnt++ == hopsStarted)
+                        break;
+                    if (hopsFailed.count(rec.oldName) == 0)
+                        renameOne(hopName, rec.newName.c_str(), pass);
+                }
+            } else if (pass == 1) {
+                renameOne(rec.oldName, rec.newName.c_str(), pass);
+            }
+        }
+        fclose(plan);
+        if (pool != nullptr) {
+            flush(pass);
+            pool->wait();
+        }
+        barrier();
+    }
+
+    // Source of a failed hop is free unless a direct rename took it, the rename back
+    // never replaces. The caller reports a temporary name left behind.
+    if (!hopsBack.empty()) {
+        Plan::pass = HOP_BACK;
+        for (const std::string& name : hopsBack)
+            rename(name.c_str(), name.substr(0, name.length() - strlen(HOP_EXT)).c_str());
+        barrier();
+    }
+    Plan::pass = NO_PASS;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Plan::close() {
+    for (const lstring& path : tmpFiles)
+        remove(path);
+    tmpFiles.clear();
+    byNewRuns.clear();
+    std::vector<Record>().swap(records);
+    enabled = false;
+}
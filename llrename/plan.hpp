@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------------------------------
+// File: plan.hpp
+// Author: Dennis Lang
+//
+// Desc: Out of core rename plan, external sort of rename records (-memLimit)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Planned rename with a fixed memory budget. The scan only records (source, target) pairs.
+// Records are sorted in memory up to memLimit and spilled as sorted runs to temporary files,
+// then merged (external sort, by directory then name):
+//   1. runs sorted by target: a target claimed by several sources keeps the first scanned,
+//      the others fail with EEXIST.
+//   2. runs sorted by source, merge joined with the targets: a source which is also a target
+//      (chain A->B, B->C or cycle A->B, B->A) is renamed via a temporary name. A target which
+//      is no source must not exist, else its rename and every rename chained onto its source
+//      fail with EEXIST before anything moves.
+//   3. apply streams the merged file three times: sources to temporary names, direct
+//      renames, temporary names to targets. A temporary name whose target rename failed is
+//      renamed back to its source.
+// Only a few records per run are in memory during a merge.
+// Renames within a pass never touch the same name, so with a batch handler each pass is
+// cut into batches of one source directory and applied by a pool of workers.
+class Plan {
+public:
+    struct Pair {
+        lstring oldName;
+        lstring newName;
+        bool okay;                  // set by batch handler
+    };
+    typedef bool (*Rename_t)(const char* oldName, const char* newName);
+    typedef void (*Batch_t)(std::vector<Pair>& batch);  // called on worker threads
+    typedef void (*Failed_t)(const char* oldName, const char* newName, int err);
+    typedef void (*Barrier_t)();    // wait for queued renames before next pass
+    typedef void (*Exists_t)(std::vector<Pair>& batch);  // clear okay if newName exists
+
+    // Pass being applied. HOP_START renames source to source + HOP_EXT, HOP_END renames
+    // that temporary name to the target, HOP_BACK to the source if HOP_END failed.
+    enum Pass { NO_PASS, HOP_START, DIRECT, HOP_END, HOP_BACK };
+    static Pass pass;
+    static const char* HOP_EXT;
+
+    static bool enabled;
+    static uint64_t memLimit;       // bytes
+    static unsigned threads;        // apply workers, 0 = ThreadPool::defaultSize(), 1 = rename()
+
+    static bool open(const char* tmpDir = nullptr);
+    static void add(const char* oldName, const char* newName);
+    static size_t size();
+
+    // Merge, detect collisions and chains, then apply. Returns false on temp file errors.
+    // Without targetExists (-force) existing targets are not checked.
+    static bool apply(Rename_t rename, Failed_t failed, Barrier_t barrier, Batch_t batchRename = nullptr,
+            Exists_t targetExists = nullptr);
+    static void close();            // remove temporary files
+};
@@ -0,0 +1,106 @@
+//-------------------------------------------------------------------------------------------------
+// File: postorder.cpp
+// Author: Dennis Lang
+//
+// Desc: Parallel bottom up directory rename (-D=threads)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "postorder.hpp"
+#include "threadpool.hpp"
+#include "signals.hpp"
+
+#include <atomic>
+#include <deque>
+
+unsigned PostOrder::threads = 0;
+
+struct PostOrder::Dir {
+    std::atomic<unsigned> pending { 1 };    // children not renamed, plus one until scan leaves
+    Dir* parent = nullptr;
+    lstring oldPath;
+    lstring newPath;
+    unsigned flags = 0;
+};
+
+static PostOrder::Apply_t applier = nullptr;
+static ThreadPool* pool = nullptr;
+static std::deque<PostOrder::Dir> dirs;     // only the scan thread adds, workers use pointers
+
+//-------------------------------------------------------------------------------------------------
+// Rename dir then walk up while this worker completed the last child of the parent.
+static void renameUp(PostOrder::Dir* dir) {
+    while (dir != nullptr) {
+        if (!dir->newPath.empty() && !Signals::aborted)
+            applier(dir->oldPath, dir->newPath, dir->flags);
+        dir = dir->parent;
+        if (dir != nullptr && dir->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            break;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void PostOrder::start(Apply_t apply) {
+    applier = apply;
+    pool = new ThreadPool(threads);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+PostOrder::Dir* PostOrder::enter(Dir* parent) {
+    dirs.emplace_back();
+    Dir* dir = &dirs.back();
+    dir->parent = parent;
+    if (parent != nullptr)
+        parent->pending.fetch_add(1, std::memory_order_relaxed);
+    return dir;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void PostOrder::leave(Dir* dir, const lstring& oldPath, const lstring& newPath, unsigned flags) {
+    dir->oldPath = oldPath;
+    dir->newPath = newPath;
+    dir->flags = flags;
+    if (dir->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        pool->add([dir]() { renameUp(dir); });
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void PostOrder::stop() {
+    if (pool == nullptr)
+        return;
+    pool->wait();
+    delete pool;
+    pool = nullptr;
+    dirs.clear();
+}
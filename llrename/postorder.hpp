@@ -0,0 +1,59 @@
+//-------------------------------------------------------------------------------------------------
+// File: postorder.hpp
+// Author: Dennis Lang
+//
+// Desc: Parallel bottom up directory rename (-D=threads)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+//-------------------------------------------------------------------------------------------------
+// Directories must be renamed after everything below them, else the paths of their
+// children change. The serial scan renames a directory as the recursion leaves it.
+// Here each scanned directory holds a count of outstanding children plus one for the scan.
+// A directory is renamed by the worker which completes its last child, or queued when the
+// scan leaves it if its children are already done, so independent subtrees rename at once.
+// Paths are taken at scan time and stay valid since no parent moves before its children.
+class PostOrder {
+public:
+    struct Dir;
+    typedef void (*Apply_t)(const lstring& oldPath, const lstring& newPath, unsigned flags);
+
+    static unsigned threads;        // 0 = serial rename as scan leaves directory
+
+    static void start(Apply_t apply);
+    static Dir* enter(Dir* parent); // parent nullptr for directory given as argument
+    // Scan is done with dir, newPath empty keeps its name.
+    static void leave(Dir* dir, const lstring& oldPath, const lstring& newPath, unsigned flags);
+    static void stop();             // wait for all renames
+};
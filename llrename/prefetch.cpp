@@ -0,0 +1,123 @@
+//-------------------------------------------------------------------------------------------------
+// File: prefetch.cpp
+// Author: Dennis Lang
+//
+// Desc: Stat prefetch ahead of the rename transform
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "prefetch.hpp"
+#include "threadpool.hpp"
+#include "signals.hpp"
+#include "stats.hpp"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+bool Prefetch::enabled = false;
+unsigned Prefetch::threads = 0;
+unsigned Prefetch::windowSize = 1024;
+unsigned Prefetch::levels = FileMeta::bit(FileMeta::STAT);
+
+struct PrefetchEntry {
+    lstring path;
+    lstring name;
+    FileMeta meta;
+    std::atomic<bool> ready { false };
+};
+
+static Prefetch::Handle_t handler = nullptr;
+static ThreadPool* pool = nullptr;
+static std::deque<std::unique_ptr<PrefetchEntry>> window;
+static std::mutex readyMutex;
+static std::condition_variable readyCond;
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Prefetch::start(Handle_t handle) {
+    handler = handle;
+    pool = new ThreadPool(threads);
+    enabled = true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Wait for oldest entry and pass it to handler, skipped after cancel.
+static void handleFront() {
+    std::unique_ptr<PrefetchEntry> entry = std::move(window.front());
+    window.pop_front();
+    if (!entry->ready) {
+        Stats::Timer timer(Stats::META_WAIT);
+        std::unique_lock<std::mutex> lock(readyMutex);
+        readyCond.wait(lock, [&entry]() { return entry->ready.load(); });
+    }
+    if (!Signals::aborted)
+        handler(entry->path, entry->name, entry->meta);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Prefetch::add(const lstring& filepath, const lstring& filename) {
+    if (window.size() >= windowSize)
+        handleFront();
+
+    PrefetchEntry* entry = new PrefetchEntry();
+    entry->path = filepath;
+    entry->name = filename;
+    window.emplace_back(entry);
+    pool->add([entry]() {
+        if (!Signals::aborted)
+            entry->meta.need(entry->path, Prefetch::levels);
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            entry->ready = true;
+        }
+        readyCond.notify_all();
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Prefetch::drain() {
+    while (!window.empty())
+        handleFront();
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Prefetch::stop() {
+    if (!enabled)
+        return;
+    drain();
+    delete pool;
+    pool = nullptr;
+    enabled = false;
+}
@@ -0,0 +1,59 @@
+//-------------------------------------------------------------------------------------------------
+// File: prefetch.hpp
+// Author: Dennis Lang
+//
+// Desc: Stat prefetch ahead of the rename transform
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+#include "filemeta.hpp"
+
+//-------------------------------------------------------------------------------------------------
+// Scanned entries enter a window of up to windowSize entries. A stat for each entry is
+// queued on a thread pool as soon as it is added, the oldest entry is handed to the
+// transform only when the window is full or drained. Entries are handled in scan order,
+// so numbering and directory post-order are unchanged, while the stat calls overlap
+// readdir and the renames of earlier entries.
+class Prefetch {
+public:
+    typedef bool (*Handle_t)(const lstring& filepath, const lstring& filename, const FileMeta& meta);
+
+    static bool enabled;
+    static unsigned threads;        // 0 = ThreadPool::defaultSize()
+    static unsigned windowSize;
+    static unsigned levels;         // FileMeta::bit() mask loaded by workers
+
+    static void start(Handle_t handle);
+    static void add(const lstring& filepath, const lstring& filename);
+    static void drain();            // handle all entries in window
+    static void stop();
+};
@@ -0,0 +1,144 @@
+//-------------------------------------------------------------------------------------------------
+// File: progress.cpp
+// Author: Dennis Lang
+//
+// Desc: Live progress line with rate and ETA (-progress)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "progress.hpp"
+#include "directory.hpp"
+#include "signals.hpp"
+
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+std::atomic<uint64_t> Progress::scanned(0);
+std::atomic<uint64_t> Progress::matched(0);
+std::atomic<uint64_t> Progress::renamed(0);
+uint64_t Progress::expected = 0;
+
+static std::thread ticker;
+static std::mutex tickMutex;
+static std::condition_variable tickCond;
+static bool tickStop = false;
+static std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+uint64_t Progress::preCount(const lstring& dirname, bool recurse) {
+    Directory_files directory(dirname);
+    lstring fullname;
+    uint64_t count = 0;
+    while (!Signals::aborted && directory.more()) {
+        count++;
+        if (recurse && directory.is_directory())
+            count += preCount(directory.fullName(fullname), recurse);
+    }
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+uint64_t Progress::lineCount(const lstring& path) {
+    uint64_t count = 0;
+    FILE* file = fopen(path, "rb");
+    if (file != nullptr) {
+        static char buf[1 << 16];
+        size_t len;
+        while ((len = fread(buf, 1, sizeof(buf), file)) != 0) {
+            for (const char* ptr = buf; (ptr = (const char*)memchr(ptr, '\n', len - (ptr - buf))) != nullptr; ptr++)
+                count++;
+        }
+        fclose(file);
+    }
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Draw progress line on stderr, '\r' keeps it on one line.
+// Called by the ticker and by the signal thread for SIGUSR1.
+void Progress::show(bool newLine) {
+    static std::mutex showMutex;
+    std::lock_guard<std::mutex> lock(showMutex);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    uint64_t done = scanned.load(std::memory_order_relaxed);
+    double rate = (secs > 0) ? done / secs : 0;
+
+    char eta[40] = "";
+    if (expected > done && rate > 0) {
+        unsigned remain = (unsigned)((expected - done) / rate);
+        snprintf(eta, sizeof(eta), " ETA %u:%02u:%02u", remain / 3600, (remain / 60) % 60, remain % 60);
+    } else if (expected != 0 && expected <= done) {
+        snprintf(eta, sizeof(eta), " ETA 0:00:00");
+    }
+
+    char total[30] = "";
+    if (expected != 0)
+        snprintf(total, sizeof(total), "/%llu", (unsigned long long)expected);
+
+    char line[200];
+    snprintf(line, sizeof(line), "\rScanned=%llu%s matched=%llu renamed=%llu rate=%.0f/s%s   %s",
+        (unsigned long long)done, total,
+        (unsigned long long)matched.load(std::memory_order_relaxed),
+        (unsigned long long)renamed.load(std::memory_order_relaxed),
+        rate, eta, newLine ? "\n" : "");
+    fputs(line, stderr);
+    fflush(stderr);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Progress::start() {
+    startTime = std::chrono::steady_clock::now();
+    tickStop = false;
+    ticker = std::thread([]() {
+        std::unique_lock<std::mutex> lock(tickMutex);
+        while (!tickCond.wait_for(lock, std::chrono::seconds(1), []() { return tickStop; })) {
+            show(false);
+        }
+    });
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void Progress::stop() {
+    if (ticker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(tickMutex);
+            tickStop = true;
+        }
+        tickCond.notify_all();
+        ticker.join();
+        show(true);
+    }
+}
@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------------------------
+// File: progress.hpp
+// Author: Dennis Lang
+//
+// Desc: Live progress line with rate and ETA (-progress)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <atomic>
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// Workers bump relaxed atomic counters, a background ticker thread reads them once a
+// second and redraws the progress line, so the per-file cost is one uncontended add.
+class Progress {
+public:
+    static std::atomic<uint64_t> scanned;   // directory entries or list lines read
+    static std::atomic<uint64_t> matched;   // passed include/exclude filters
+    static std::atomic<uint64_t> renamed;
+    static uint64_t expected;               // estimated total scanned, 0 if unknown
+
+    static void inc(std::atomic<uint64_t>& counter) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Quick pre-count of directory entries for ETA, readdir only, no stat.
+    static uint64_t preCount(const lstring& dirname, bool recurse);
+    // Number of lines in file, used as expected count for -fromList.
+    static uint64_t lineCount(const lstring& path);
+
+    static void start();    // start ticker thread
+    static void stop();     // stop ticker and end progress line
+    static void show(bool newLine);
+};
@@ -42,23 +42,41 @@
 #undef byte                     // Fix for c++ v17
 #else
 #include <signal.h>
+#include <thread>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/signalfd.h>
+#endif
 #endif
 
 
-volatile bool Signals::aborted = false;    // Set true by signal handler
-volatile unsigned int Signals::abortCnt = 0;
+std::atomic<bool> Signals::aborted(false);    // Set true by signal handler
+std::atomic<unsigned> Signals::abortCnt(0);
+Signals::ExitHook_t Signals::exitHook = nullptr;
+Signals::ProgressHook_t Signals::progressHook = nullptr;
 
+//-------------------------------------------------------------------------------------------------
+// Request cancel, third request flushes journals and exits.
+static void cancelRequest(const char* what) {
+    Signals::aborted = true;
+    std::cerr << "\nCaught signal " << what << ", finishing current rename \a" << std::endl;
+    if (Signals::abortCnt++ >= 2) {
+        std::cerr << "Forced exit" << std::endl;
+        if (Signals::exitHook != nullptr)
+            Signals::exitHook();
+        _exit(-1);
+    }
+}
 
 #ifdef HAVE_WIN
 //-------------------------------------------------------------------------------------------------
 BOOL WINAPI CtrlHandler(DWORD fdwCtrlType) {
     switch (fdwCtrlType) {
     case CTRL_C_EVENT:  // Handle the CTRL-C signal.
-        Signals::aborted = true;
-        std::cerr << "\nCaught signal " << std::endl;
+    case CTRL_BREAK_EVENT:
+    case CTRL_CLOSE_EVENT:
         Beep(750, 300);
-        if (Signals::abortCnt++ >= 2)
-            exit(-1);
+        cancelRequest("Ctrl-C");
         return TRUE;
     }
 
@@ -75,24 +93,50 @@ void Signals::init() {
 #else
 
 //-------------------------------------------------------------------------------------------------
-void sigHandler(int /* sig_t */ s) {
-    Signals::aborted = true;
-    std::cerr << "\nCaught signal \a " << std::endl;
-    if (Signals::abortCnt++ >= 2)
-        exit(-1);
+static void handleSignal(int sig) {
+    if (sig == SIGUSR1) {
+        // Called on the signal thread, so a long plan, flush or copy still reports.
+        if (Signals::progressHook != nullptr)
+            Signals::progressHook();
+    } else
+        cancelRequest(strsignal(sig));
 }
 
 //-------------------------------------------------------------------------------------------------
+// Block signals in every thread, the signal thread receives them synchronously.
 void Signals::init() {
-    // signal(SIGINT, sigHandler);
+    sigset_t sigSet;
+    sigemptyset(&sigSet);
+    sigaddset(&sigSet, SIGINT);
+    sigaddset(&sigSet, SIGTERM);
+    sigaddset(&sigSet, SIGHUP);
+    sigaddset(&sigSet, SIGUSR1);
+    if (pthread_sigmask(SIG_BLOCK, &sigSet, NULL) != 0) {
+        std::cerr << "Failed to install sig handler" << endl;
+        return;
+    }
 
-    struct sigaction sigIntHandler;
-    sigIntHandler.sa_handler = sigHandler;
-    sigemptyset(&sigIntHandler.sa_mask);
-    sigIntHandler.sa_flags = 0;
-    if (sigaction(SIGINT, &sigIntHandler, NULL) != 0) {
+#ifdef __linux__
+    int sigFd = signalfd(-1, &sigSet, SFD_CLOEXEC);
+    if (sigFd == -1) {
         std::cerr << "Failed to install sig handler" << endl;
+        pthread_sigmask(SIG_UNBLOCK, &sigSet, NULL);
+        return;
     }
+    std::thread([sigFd]() {
+        struct signalfd_siginfo info;
+        while (read(sigFd, &info, sizeof(info)) == sizeof(info)) {
+            handleSignal((int)info.ssi_signo);
+        }
+    }).detach();
+#else
+    std::thread([sigSet]() {
+        int sig;
+        while (sigwait(&sigSet, &sig) == 0) {
+            handleSignal(sig);
+        }
+    }).detach();
+#endif
 }
 
 #endif
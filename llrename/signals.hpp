@@ -32,13 +32,27 @@
 // IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
+#pragma once
+
 #include "ll_stdhdr.hpp"
 
+#include <atomic>
+
 //-------------------------------------------------------------------------------------------------
+// SIGINT, SIGTERM and SIGHUP request cooperative cancel, workers poll 'aborted' between items
+// so an in-flight rename always completes. A third signal runs exitHook and exits.
+// On Linux the signals are read from a signalfd by a dedicated thread, other unix
+// systems use sigwait on the same thread, so handling is not limited to async-signal-safe calls.
 class Signals {
 public:
-    static volatile bool aborted;
-    static volatile unsigned int abortCnt;
+    typedef void (*ExitHook_t)();
+    typedef void (*ProgressHook_t)();
+
+    static std::atomic<bool> aborted;
+    static std::atomic<unsigned> abortCnt;
+    static ExitHook_t exitHook;             // Flush journals before forced exit
+    static ProgressHook_t progressHook;     // Show progress on SIGUSR1, in any phase
 
+    // Call before starting any threads so they inherit the blocked signal mask.
     static void init();
 };
@@ -0,0 +1,195 @@
+//-------------------------------------------------------------------------------------------------
+// File: sortorder.cpp
+// Author: Dennis Lang
+//
+// Desc: Order of directory entries for numbering (-sort)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "sortorder.hpp"
+#include "ioring.hpp"
+#include "threadpool.hpp"
+#include "stats.hpp"
+
+#include <string.h>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <algorithm>
+
+static const size_t STAT_BATCH = 256;       // stat operations per IoRing::run
+static const size_t PAR_MIN = 32 * 1024;    // entries per parallel sort chunk
+
+struct SortKey {
+    int64_t num;                // mtime ns or size
+    std::string natural;        // natural order key
+    std::string_view name;      // name in path tree arena
+    PathTree::Node node;
+
+    bool operator<(const SortKey& other) const {
+        if (num != other.num)
+            return num < other.num;
+        int cmp = natural.compare(other.natural);
+        if (cmp != 0)
+            return cmp < 0;
+        return name < other.name;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+bool SortOrder::parse(const char* value, By& by) {
+    static const char* NAMES[] = { "name", "natural", "mtime", "size" };
+    static const By BYS[] = { NAME, NATURAL, MTIME, SIZE };
+    for (unsigned idx = 0; idx < sizeof(NAMES) / sizeof(NAMES[0]); idx++) {
+        if (strcmp(value, NAMES[idx]) == 0) {
+            by = BYS[idx];
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Name with each digit run replaced by '0', run length, digits without leading zeros,
+// so plain byte compare orders file9 before file10.
+static void naturalKey(std::string_view name, std::string& key) {
+    key.clear();
+    key.reserve(name.length() + 4);
+    for (size_t pos = 0; pos < name.length(); ) {
+        if (!isdigit((unsigned char)name[pos])) {
+            key += name[pos++];
+            continue;
+        }
+        while (pos < name.length() && name[pos] == '0')
+            pos++;
+        size_t end = pos;
+        while (end < name.length() && isdigit((unsigned char)name[end]))
+            end++;
+        key += '0';
+        key += (char)std::min(end - pos, (size_t)255);
+        key.append(name.data() + pos, end - pos);
+        pos = end;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+static int64_t statKey(SortOrder::By by, const struct stat& info) {
+    if (by == SortOrder::SIZE)
+        return (int64_t)info.st_size;
+#if defined(__APPLE__)
+    return (int64_t)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined(HAVE_WIN)
+    return (int64_t)info.st_mtime * 1000000000;
+#else
+    return (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+// Stat entries in batches, io_uring statx on Linux. Entries which fail keep key 0.
+static void loadStatKeys(SortOrder::By by, const PathTree& paths, std::vector<SortKey>& keys) {
+    static IoRing ring((unsigned)STAT_BATCH);
+    std::vector<lstring> batchPaths(STAT_BATCH);
+    std::vector<struct stat> infos(STAT_BATCH);
+    std::vector<IoRing::Op> ops;
+    ops.reserve(STAT_BATCH);
+
+    for (size_t off = 0; off < keys.size(); off += STAT_BATCH) {
+        size_t cnt = std::min(STAT_BATCH, keys.size() - off);
+        ops.clear();
+        for (size_t idx = 0; idx < cnt; idx++) {
+            paths.path(keys[off + idx].node, batchPaths[idx]);
+            ops.push_back(IoRing::Op { IoRing::Op::STAT, batchPaths[idx], nullptr, 0, &infos[idx], 0 });
+        }
+        ring.run(ops);
+        for (size_t idx = 0; idx < cnt; idx++) {
+            if (ops[idx].result == 0)
+                keys[off + idx].num = statKey(by, infos[idx]);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Sort chunks on a pool then merge neighbours, doubling the run length each round.
+static void parallelSort(std::vector<SortKey>& keys) {
+    ThreadPool pool;
+    size_t chunks = std::min((size_t)pool.size(), keys.size() / PAR_MIN);
+    if (chunks < 2) {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+
+    size_t chunkLen = (keys.size() + chunks - 1) / chunks;
+    for (size_t beg = 0; beg < keys.size(); beg += chunkLen) {
+        size_t end = std::min(beg + chunkLen, keys.size());
+        pool.add([&keys, beg, end]() { std::sort(keys.begin() + beg, keys.begin() + end); });
+    }
+    pool.wait();
+
+    for (size_t runLen = chunkLen; runLen < keys.size(); runLen *= 2) {
+        for (size_t beg = 0; beg + runLen < keys.size(); beg += 2 * runLen) {
+            size_t mid = beg + runLen;
+            size_t end = std::min(beg + 2 * runLen, keys.size());
+            pool.add([&keys, beg, mid, end]() {
+                std::inplace_merge(keys.begin() + beg, keys.begin() + mid, keys.begin() + end);
+            });
+        }
+        pool.wait();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+void SortOrder::sort(By by, const PathTree& paths, PathTree::Node firstNode, PathTree::Node endNode,
+        std::vector<PathTree::Node>& order) {
+    Stats::Timer timer(Stats::SORT);
+    std::vector<SortKey> keys(endNode - firstNode);
+    for (PathTree::Node node = firstNode; node < endNode; node++) {
+        SortKey& key = keys[node - firstNode];
+        key.num = 0;
+        key.name = std::string_view(paths.name(node), paths.nameLen(node));
+        key.node = node;
+        if (by == NATURAL)
+            naturalKey(key.name, key.natural);
+    }
+    if (by == MTIME || by == SIZE)
+        loadStatKeys(by, paths, keys);
+
+    if (keys.size() >= 2 * PAR_MIN)
+        parallelSort(keys);
+    else
+        std::sort(keys.begin(), keys.end());
+
+    order.clear();
+    order.reserve(keys.size());
+    for (const SortKey& key : keys)
+        order.push_back(key.node);
+}
@@ -0,0 +1,58 @@
+//-------------------------------------------------------------------------------------------------
+// File: sortorder.hpp
+// Author: Dennis Lang
+//
+// Desc: Order of directory entries for numbering (-sort)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+#include "pathtree.hpp"
+
+#include <vector>
+
+//-------------------------------------------------------------------------------------------------
+// Order of a directory listing, so -startNum numbering does not follow readdir order,
+// which differs between runs on hashed directories (ext4, XFS).
+// A key is built once per entry (natural digit runs, mtime or size from batched stat),
+// then entries are sorted by key and name. Large directories sort chunks in parallel
+// and merge them.
+class SortOrder {
+public:
+    enum By { NONE, NAME, NATURAL, MTIME, SIZE };
+
+    static bool parse(const char* value, By& by);     // name|natural|mtime|size
+
+    // Fill order with nodes firstNode to endNode of the same directory, sorted by key.
+    static void sort(By by, const PathTree& paths, PathTree::Node firstNode, PathTree::Node endNode,
+        std::vector<PathTree::Node>& order);
+};
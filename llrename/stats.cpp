@@ -0,0 +1,206 @@
+//-------------------------------------------------------------------------------------------------
+// File: stats.cpp
+// Author: Dennis Lang
+//
+// Desc: Run statistics, phase timing and counters (-stats)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "stats.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <iomanip>
+
+#ifdef HAVE_WIN
+#define byte win_byte_override  // Fix for c++ v17
+#include <windows.h>
+#undef byte                     // Fix for c++ v17
+#else
+#include <time.h>
+#endif
+
+bool Stats::enabled = false;
+
+static std::mutex statsMutex;
+static std::vector<std::unique_ptr<Stats::Counts>> allCounts;   // one per thread, merged by report()
+static thread_local Stats::Counts* threadCounts = nullptr;
+
+static const char* PHASE_NAMES[] = { "other", "scan", "filter", "sort", "transform", "rename", "list I/O", "meta wait" };
+static const char* COUNTER_NAMES[] = {
+    "Directories", "Entries", "Pattern evals",
+    "stat", "access", "chdir", "rename", "open", "Bytes read", "Bytes copied", "Cloned", "Hash cached", "Name cached", "Renamed" };
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+Stats::Counts& Stats::local() {
+    if (threadCounts == nullptr) {
+        std::unique_ptr<Counts> counts(new Counts());
+        memset(counts.get(), 0, sizeof(Counts));
+        counts->phaseWall = wallNow();
+        counts->phaseCpu = cpuNow();
+        threadCounts = counts.get();
+        std::lock_guard<std::mutex> lock(statsMutex);
+        allCounts.push_back(std::move(counts));
+    }
+    return *threadCounts;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Charge time to the active phase and switch to 'phase', return previous phase.
+Stats::Phase Stats::enter(Phase phase) {
+    Counts& counts = local();
+    uint64_t wall = wallNow();
+    uint64_t cpu = cpuNow();
+    counts.wallNs[counts.phase] += wall - counts.phaseWall;
+    counts.cpuNs[counts.phase] += cpu - counts.phaseCpu;
+    counts.phaseWall = wall;
+    counts.phaseCpu = cpu;
+
+    Phase prevPhase = counts.phase;
+    counts.phase = phase;
+    return prevPhase;
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Record one rename latency in a log2 microsecond histogram.
+void Stats::latency(uint64_t nanoSec) {
+    if (enabled) {
+        uint64_t micro = nanoSec / 1000;
+        unsigned bucket = 0;
+        while (micro != 0 && bucket + 1 < LATENCY_CNT) {
+            micro >>= 1;
+            bucket++;
+        }
+        local().latency[bucket]++;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static]
+uint64_t Stats::wallNow() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Process start, phase times add up over threads so throughput uses elapsed time.
+static const uint64_t startWall = Stats::wallNow();
+
+//-------------------------------------------------------------------------------------------------
+// [static] Cpu time used by calling thread.
+uint64_t Stats::cpuNow() {
+#ifdef HAVE_WIN
+    FILETIME createTm, exitTm, kernelTm, userTm;
+    GetThreadTimes(GetCurrentThread(), &createTm, &exitTm, &kernelTm, &userTm);
+    uint64_t kernel = ((uint64_t)kernelTm.dwHighDateTime << 32) | kernelTm.dwLowDateTime;
+    uint64_t user = ((uint64_t)userTm.dwHighDateTime << 32) | userTm.dwLowDateTime;
+    return (kernel + user) * 100;   // 100ns units
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------
+// Return upper bound in micro-seconds of histogram bucket holding percentile 'pct'.
+static uint64_t percentile(const uint64_t* histo, unsigned cnt, uint64_t total, double pct) {
+    uint64_t want = (uint64_t)(total * pct);
+    uint64_t sum = 0;
+    for (unsigned idx = 0; idx < cnt; idx++) {
+        sum += histo[idx];
+        if (sum > want)
+            return (uint64_t)1 << idx;
+    }
+    return (uint64_t)1 << (cnt - 1);
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Merge per-thread counts and print summary.
+void Stats::report(std::ostream& out) {
+    if (!enabled)
+        return;
+    enter(local().phase);     // charge current thread's open phase
+
+    Counts total;
+    memset(&total, 0, sizeof(total));
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        for (const auto& counts : allCounts) {
+            for (unsigned idx = 0; idx < PHASE_CNT; idx++) {
+                total.wallNs[idx] += counts->wallNs[idx];
+                total.cpuNs[idx] += counts->cpuNs[idx];
+            }
+            for (unsigned idx = 0; idx < COUNTER_CNT; idx++)
+                total.counters[idx] += counts->counters[idx];
+            for (unsigned idx = 0; idx < ERRNO_CNT; idx++)
+                total.failures[idx] += counts->failures[idx];
+            for (unsigned idx = 0; idx < LATENCY_CNT; idx++)
+                total.latency[idx] += counts->latency[idx];
+        }
+    }
+
+    uint64_t elapsed = wallNow() - startWall;
+    out << "--- Stats ---\n";
+    out << std::fixed << std::setprecision(3);
+    out << std::left << std::setw(12) << "elapsed" << " wall=" << std::right << std::setw(10) << elapsed / 1e9 << "s\n";
+    for (unsigned idx = 1; idx < PHASE_CNT; idx++) {
+        out << std::left << std::setw(12) << PHASE_NAMES[idx]
+            << " wall=" << std::right << std::setw(10) << total.wallNs[idx] / 1e9
+            << "s  cpu=" << std::setw(10) << total.cpuNs[idx] / 1e9 << "s\n";
+    }
+
+    for (unsigned idx = 0; idx < COUNTER_CNT; idx++) {
+        out << std::left << std::setw(14) << COUNTER_NAMES[idx] << "= " << total.counters[idx] << "\n";
+    }
+    out << std::right;
+
+    for (unsigned idx = 0; idx < ERRNO_CNT; idx++) {
+        if (total.failures[idx] != 0)
+            out << "Failed errno=" << idx << " " << strerror((int)idx) << " count=" << total.failures[idx] << "\n";
+    }
+
+    uint64_t samples = 0;
+    for (unsigned idx = 0; idx < LATENCY_CNT; idx++)
+        samples += total.latency[idx];
+    if (samples != 0) {
+        out << "Rename latency  p50<=" << percentile(total.latency, LATENCY_CNT, samples, 0.50)
+            << "us  p90<=" << percentile(total.latency, LATENCY_CNT, samples, 0.90)
+            << "us  p99<=" << percentile(total.latency, LATENCY_CNT, samples, 0.99)
+            << "us\n";
+    }
+    if (elapsed != 0) {
+        out << std::setprecision(1)
+            << "Throughput entries/sec=" << total.counters[ENTRIES] * 1e9 / elapsed
+            << " renamed/sec=" << total.counters[RENAMED] * 1e9 / elapsed << "\n";
+    }
+    out << "--- End Stats ---\n";
+}
@@ -0,0 +1,105 @@
+//-------------------------------------------------------------------------------------------------
+// File: stats.hpp
+// Author: Dennis Lang
+//
+// Desc: Run statistics, phase timing and counters (-stats)
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "ll_stdhdr.hpp"
+
+#include <iostream>
+#include <stdint.h>
+
+//-------------------------------------------------------------------------------------------------
+// Counters are kept per thread and merged by report(), so collecting them needs no locking.
+// When Stats::enabled is false every hook is a single branch on a static bool.
+class Stats {
+public:
+    enum Phase { NONE, SCAN, FILTER, SORT, TRANSFORM, RENAME, LIST_IO, META_WAIT, PHASE_CNT };
+    enum Counter { DIRS, ENTRIES, PATTERN_EVALS, SYS_STAT, SYS_ACCESS, SYS_CHDIR, SYS_RENAME, SYS_OPEN, BYTES_READ, BYTES_COPIED, CLONED, HASH_CACHED, NAME_CACHED, RENAMED, COUNTER_CNT };
+    static const unsigned ERRNO_CNT = 160;
+    static const unsigned LATENCY_CNT = 40;     // log2 micro-second buckets
+
+    struct Counts {
+        uint64_t wallNs[PHASE_CNT];
+        uint64_t cpuNs[PHASE_CNT];
+        uint64_t counters[COUNTER_CNT];
+        uint64_t failures[ERRNO_CNT];
+        uint64_t latency[LATENCY_CNT];
+        Phase    phase;
+        uint64_t phaseWall;
+        uint64_t phaseCpu;
+    };
+
+    static bool enabled;
+
+    static void add(Counter counter, uint64_t cnt = 1) {
+        if (enabled)
+            local().counters[counter] += cnt;
+    }
+    static void failure(int err) {
+        if (enabled)
+            local().failures[(unsigned)err < ERRNO_CNT ? err : 0]++;
+    }
+    static void latency(uint64_t nanoSec);
+
+    static uint64_t wallNow();
+    static uint64_t cpuNow();
+
+    static void report(std::ostream& out);
+
+    // Charge elapsed time to 'phase' while in scope, nested timers pause the outer phase.
+    class Timer {
+        Phase prevPhase;
+        uint64_t startNs;
+    public:
+        Timer(Phase phase) : prevPhase(NONE), startNs(0) {
+            if (enabled) {
+                startNs = wallNow();
+                prevPhase = enter(phase);
+            }
+        }
+        ~Timer() {
+            if (enabled) {
+                enter(prevPhase);
+            }
+        }
+        // Time since timer started, only valid when stats enabled.
+        uint64_t elapsedNs() const {
+            return enabled ? wallNow() - startNs : 0;
+        }
+    };
+
+private:
+    static Counts& local();
+    static Phase enter(Phase phase);
+};
@@ -0,0 +1,97 @@
+//-------------------------------------------------------------------------------------------------
+// File: threadpool.cpp
+// Author: Dennis Lang
+//
+// Desc: Fixed size pool of worker threads
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include "threadpool.hpp"
+
+#include <algorithm>
+
+//-------------------------------------------------------------------------------------------------
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0)
+        threads = defaultSize();
+    for (unsigned idx = 0; idx < threads; idx++)
+        workers.emplace_back(&ThreadPool::work, this);
+}
+
+//-------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    workCond.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+//-------------------------------------------------------------------------------------------------
+// [static] Twice the cores, workers mostly wait on the filesystem.
+unsigned ThreadPool::defaultSize() {
+    unsigned cores = std::thread::hardware_concurrency();
+    return std::min(std::max(cores * 2, 4u), 64u);
+}
+
+//-------------------------------------------------------------------------------------------------
+void ThreadPool::add(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        tasks.push_back(std::move(task));
+    }
+    workCond.notify_one();
+}
+
+//-------------------------------------------------------------------------------------------------
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    doneCond.wait(lock, [this]() { return tasks.empty() && busy == 0; });
+}
+
+//-------------------------------------------------------------------------------------------------
+void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(poolMutex);
+    for (;;) {
+        workCond.wait(lock, [this]() { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+            return;     // stopping
+        Task task = std::move(tasks.front());
+        tasks.pop_front();
+        busy++;
+        lock.unlock();
+        task();
+        lock.lock();
+        busy--;
+        if (tasks.empty() && busy == 0)
+            doneCond.notify_all();
+    }
+}
@@ -0,0 +1,71 @@
+//-------------------------------------------------------------------------------------------------
+// File: threadpool.hpp
+// Author: Dennis Lang
+//
+// Desc: Fixed size pool of worker threads
+//
+//-------------------------------------------------------------------------------------------------
+//
+// Author: Dennis Lang - 2026
+// https://landenlabs.com
+//
+//
+//
+// ----- License ----
+//
+// Copyright (c) 2026 Dennis Lang
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include <functional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+//-------------------------------------------------------------------------------------------------
+// Workers take tasks from one FIFO queue. Used for stat prefetch and other per file work
+// which blocks on I/O, so the pool may be larger than the number of cores.
+class ThreadPool {
+public:
+    typedef std::function<void()> Task;
+
+    ThreadPool(unsigned threads = 0);   // 0 = defaultSize()
+    ~ThreadPool();                      // finishes queued tasks
+
+    void add(Task task);
+    void wait();                        // until queue is empty and workers are idle
+    unsigned size() const { return (unsigned)workers.size(); }
+
+    static unsigned defaultSize();
+
+private:
+    ThreadPool(const ThreadPool&);
+    void work();
+
+    std::vector<std::thread> workers;
+    std::deque<Task> tasks;
+    std::mutex poolMutex;
+    std::condition_variable workCond;
+    std::condition_variable doneCond;
+    unsigned busy = 0;
+    bool stopping = false;
+};